@@ -0,0 +1,168 @@
+/*
+ALMACÉN COMPRIMIDO DE ÓRDENES
+Guarda las órdenes ya ordenadas por fecha en bloques de 128, empacadas a nivel de bits:
+- Fecha: la primera del bloque completa y las demás como diferencia con la anterior
+  (en orden por fecha las diferencias son pequeñas)
+- Restaurante y platillo: su ID del diccionario con los bits justos (hay cientos, no millones)
+- Precio: diferencia contra el mínimo del bloque (caben en ~10 bits)
+Cada bloque guarda su fecha mínima y máxima, así una búsqueda por rango solo
+decodifica los bloques que tocan el rango y salta los demás.
+
+Autores: Equipo SProblema 5
+ - Franco Varela Villegas - A01199186
+ - Nerik Nieto Gutiérrez - A01739652
+ - Eduardo Mora Howard - A00829920
+*/
+
+#ifndef ALMACEN_COMPRIMIDO_H
+#define ALMACEN_COMPRIMIDO_H
+
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+#define ORDENES_POR_BLOQUE 128
+
+// Bits necesarios para representar 'valor'
+inline int bitsNecesarios(uint64_t valor) {
+    return valor == 0 ? 0 : 64 - __builtin_clzll(valor);
+}
+
+// Una orden ya decodificada
+struct OrdenDecodificada {
+    unsigned long int fecha;
+    int idRestaurante;
+    int idPlatillo;
+    unsigned int precio;
+};
+
+// Metadatos de un bloque; los datos viven en el flujo de bits compartido
+struct BloqueComprimido {
+    unsigned long int fechaMin;
+    unsigned long int fechaMax;
+    size_t bitInicio;       // posición del bloque dentro del flujo
+    unsigned int precioMin;
+    unsigned char bitsDelta;
+    unsigned char bitsPrecio;
+    unsigned char cantidad;
+};
+
+struct AlmacenComprimido {
+    vector<uint64_t> flujo;
+    vector<BloqueComprimido> bloques;
+    size_t total = 0;
+    int bitsRestaurante = 0;
+    int bitsPlatillo = 0;
+
+    // --- EMPACADO DE BITS ---
+
+    void escribirBits(size_t& pos, uint64_t valor, int ancho) {
+        if (ancho == 0) return;
+        size_t palabra = pos >> 6, desplazamiento = pos & 63;
+        if (palabra + 1 >= flujo.size()) flujo.resize(palabra + 2, 0);
+        flujo[palabra] |= valor << desplazamiento;
+        if (desplazamiento + ancho > 64) flujo[palabra + 1] |= valor >> (64 - desplazamiento);
+        pos += ancho;
+    }
+
+    uint64_t leerBits(size_t& pos, int ancho) const {
+        if (ancho == 0) return 0;
+        size_t palabra = pos >> 6, desplazamiento = pos & 63;
+        uint64_t valor = flujo[palabra] >> desplazamiento;
+        if (desplazamiento + ancho > 64) valor |= flujo[palabra + 1] << (64 - desplazamiento);
+        pos += ancho;
+        return ancho == 64 ? valor : valor & ((1ULL << ancho) - 1);
+    }
+
+    // Comprime las columnas recorridas en el orden dado por 'orden' (índices ya ordenados por fecha)
+    void construir(const vector<unsigned long int>& fechas, const vector<int>& idRestaurante,
+                   const vector<int>& idPlatillo, const vector<unsigned int>& precios,
+                   const vector<int>& orden, int numRestaurantes, int numPlatillos) {
+        total = orden.size();
+        bitsRestaurante = bitsNecesarios(numRestaurantes > 0 ? numRestaurantes - 1 : 0);
+        bitsPlatillo = bitsNecesarios(numPlatillos > 0 ? numPlatillos - 1 : 0);
+        flujo.clear();
+        bloques.clear();
+
+        size_t pos = 0;
+        for (size_t inicio = 0; inicio < total; inicio += ORDENES_POR_BLOQUE) {
+            size_t fin = min(total, inicio + (size_t)ORDENES_POR_BLOQUE);
+            BloqueComprimido bloque;
+            bloque.cantidad = fin - inicio;
+            bloque.fechaMin = fechas[orden[inicio]];
+            bloque.fechaMax = fechas[orden[fin - 1]];
+            bloque.bitInicio = pos;
+
+            // Anchos del bloque: mayor diferencia entre fechas y rango de precios
+            unsigned long int deltaMax = 0;
+            unsigned int precioMin = precios[orden[inicio]], precioMax = precioMin;
+            for (size_t i = inicio; i < fin; i++) {
+                if (i > inicio) deltaMax = max(deltaMax, fechas[orden[i]] - fechas[orden[i - 1]]);
+                precioMin = min(precioMin, precios[orden[i]]);
+                precioMax = max(precioMax, precios[orden[i]]);
+            }
+            bloque.precioMin = precioMin;
+            bloque.bitsDelta = bitsNecesarios(deltaMax);
+            bloque.bitsPrecio = bitsNecesarios(precioMax - precioMin);
+
+            for (size_t i = inicio + 1; i < fin; i++) {
+                escribirBits(pos, fechas[orden[i]] - fechas[orden[i - 1]], bloque.bitsDelta);
+            }
+            for (size_t i = inicio; i < fin; i++) {
+                escribirBits(pos, idRestaurante[orden[i]], bitsRestaurante);
+                escribirBits(pos, idPlatillo[orden[i]], bitsPlatillo);
+                escribirBits(pos, precios[orden[i]] - precioMin, bloque.bitsPrecio);
+            }
+            bloques.push_back(bloque);
+        }
+        flujo.resize((pos + 63) / 64 + 1);
+        flujo.shrink_to_fit();
+        bloques.shrink_to_fit();
+    }
+
+    // Decodifica un bloque completo en 'salida' (al menos ORDENES_POR_BLOQUE lugares)
+    void decodificarBloque(size_t b, OrdenDecodificada* salida) const {
+        const BloqueComprimido& bloque = bloques[b];
+        size_t pos = bloque.bitInicio;
+        unsigned long int fecha = bloque.fechaMin;
+        salida[0].fecha = fecha;
+        for (int i = 1; i < bloque.cantidad; i++) {
+            fecha += leerBits(pos, bloque.bitsDelta);
+            salida[i].fecha = fecha;
+        }
+        for (int i = 0; i < bloque.cantidad; i++) {
+            salida[i].idRestaurante = leerBits(pos, bitsRestaurante);
+            salida[i].idPlatillo = leerBits(pos, bitsPlatillo);
+            salida[i].precio = bloque.precioMin + leerBits(pos, bloque.bitsPrecio);
+        }
+    }
+
+    // Primera posición con fecha >= 'fecha' (o > si 'estricto'). Solo decodifica un bloque
+    size_t buscarPosicion(unsigned long int fecha, bool estricto) const {
+        size_t izq = 0, der = bloques.size();
+        while (izq < der) {
+            size_t mitad = (izq + der) / 2;
+            bool antes = estricto ? bloques[mitad].fechaMax <= fecha : bloques[mitad].fechaMax < fecha;
+            if (antes) izq = mitad + 1;
+            else der = mitad;
+        }
+        if (izq == bloques.size()) return total;
+
+        const BloqueComprimido& bloque = bloques[izq];
+        size_t pos = bloque.bitInicio;
+        unsigned long int actual = bloque.fechaMin;
+        int i = 0;
+        while (i < bloque.cantidad && (estricto ? actual <= fecha : actual < fecha)) {
+            i++;
+            if (i < bloque.cantidad) actual += leerBits(pos, bloque.bitsDelta);
+        }
+        return izq * ORDENES_POR_BLOQUE + i;
+    }
+
+    size_t bytesUsados() const {
+        return flujo.size() * sizeof(uint64_t) + bloques.size() * sizeof(BloqueComprimido);
+    }
+};
+
+#endif
@@ -0,0 +1,79 @@
+/*
+SEGMENTOS ORDENADOS ESTILO LSM
+Para no reordenar toda la bitácora cada vez que llegan órdenes nuevas:
+- Cada lote nuevo se ordena solo y se guarda como un segmento pequeño junto al principal
+- Las búsquedas por rango mezclan los resultados de todos los segmentos
+- Cuando hay demasiados segmentos, un hilo en segundo plano los compacta con el
+  principal; el resultado se publica desde el hilo del menú entre una opción y otra
+El costo de agregar un lote es proporcional al lote, no a toda la historia.
+
+Autores: Equipo SProblema 5
+ - Franco Varela Villegas - A01199186
+ - Nerik Nieto Gutiérrez - A01739652
+ - Eduardo Mora Howard - A00829920
+*/
+
+#ifndef ALMACEN_LSM_H
+#define ALMACEN_LSM_H
+
+#include <vector>
+#include <algorithm>
+
+#include "matriz_wavelet.h"
+#include "almacen_comprimido.h"
+#include "indice_compuesto.h"
+
+using namespace std;
+
+// Segmentos pendientes que disparan una compactación
+#define MAX_SEGMENTOS 4
+
+// Lote reciente: índices de órdenes (posiciones en las columnas) ordenados por fecha
+struct Segmento {
+    vector<int> indices;
+};
+
+// Lo que produce el hilo de compactación; se instala de una vez en el motor
+struct ResultadoCompactacion {
+    int segmentosIncluidos = 0;
+    vector<int> principal;          // modo normal
+    AlmacenComprimido comprimidas;  // modo comprimido
+    MatrizWavelet platillos;
+    IndiceCompuesto porRestaurante;
+    IndiceCompuesto porPlatillo;
+};
+
+// Posiciones [desde, hasta) de un arreglo de índices ordenado con fecha en [fechaInicio, fechaFin]
+inline void rangoEnIndices(const vector<int>& indices, const vector<unsigned long int>& fechas,
+                           unsigned long int fechaInicio, unsigned long int fechaFin,
+                           size_t& desde, size_t& hasta) {
+    desde = lower_bound(indices.begin(), indices.end(), fechaInicio,
+        [&fechas](int id, unsigned long int f) { return fechas[id] < f; }) - indices.begin();
+    hasta = upper_bound(indices.begin(), indices.end(), fechaFin,
+        [&fechas](unsigned long int f, int id) { return f < fechas[id]; }) - indices.begin();
+    if (hasta < desde) hasta = desde;
+}
+
+// Mezcla varias corridas ordenadas en una sola. En empates gana la corrida anterior,
+// que siempre es la más vieja, así se respeta el orden de llegada
+inline vector<int> mezclarCorridas(const vector<const vector<int>*>& corridas, const vector<unsigned long int>& fechas) {
+    size_t total = 0;
+    for (size_t c = 0; c < corridas.size(); c++) total += corridas[c]->size();
+
+    vector<int> resultado;
+    resultado.reserve(total);
+    vector<size_t> pos(corridas.size(), 0);
+    while (resultado.size() < total) {
+        int elegida = -1;
+        for (size_t c = 0; c < corridas.size(); c++) {
+            if (pos[c] == corridas[c]->size()) continue;
+            if (elegida == -1 || fechas[(*corridas[c])[pos[c]]] < fechas[(*corridas[elegida])[pos[elegida]]]) {
+                elegida = c;
+            }
+        }
+        resultado.push_back((*corridas[elegida])[pos[elegida]++]);
+    }
+    return resultado;
+}
+
+#endif
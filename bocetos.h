@@ -0,0 +1,202 @@
+/*
+BOCETOS (SKETCHES) STREAMING Y FUSIONABLES
+Resúmenes de tamaño acotado que se actualizan al ingerir cada orden:
+- KLL: cuantiles aproximados del precio (p50, p95 del ticket). Guarda O(k log(n/k))
+  valores sin importar cuántas órdenes lleguen
+- HyperLogLog: número aproximado de platillos distintos con 2^BITS_HLL registros de un byte
+Los dos se pueden fusionar: dos bocetos de partes distintas de la bitácora (hilos o
+fragmentos) se combinan en el boceto de la unión sin volver a leer las órdenes.
+
+Autores: Equipo SProblema 5
+ - Franco Varela Villegas - A01199186
+ - Nerik Nieto Gutiérrez - A01739652
+ - Eduardo Mora Howard - A00829920
+*/
+
+#ifndef BOCETOS_H
+#define BOCETOS_H
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+
+using namespace std;
+
+#define K_KLL 200
+#define BITS_HLL 10
+#define REGISTROS_HLL (1 << BITS_HLL)
+
+// Mezcla de bits (splitmix64) para repartir IDs consecutivos en todo el rango de 64 bits
+inline uint64_t mezclarHash(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// --- KLL: CUANTILES ---
+// Cada nivel h guarda valores que representan 2^h órdenes. Cuando un nivel se llena
+// se ordena y se sube al siguiente uno de cada dos valores
+struct BocetoKLL {
+    vector<vector<unsigned int>> niveles;
+    size_t n = 0;         // órdenes vistas
+    size_t tamano = 0;    // valores guardados en todos los niveles
+    size_t limite = 0;    // suma de capacidades; solo cambia cuando se agrega un nivel
+    uint64_t moneda = 1;  // para escoger pares o nones al compactar
+
+    int capacidad(int nivel) const {
+        int alto = niveles.size();
+        int c = (int)ceil(K_KLL * pow(2.0 / 3.0, alto - 1 - nivel));
+        return max(2, c);
+    }
+
+    size_t guardados() const {
+        size_t total = 0;
+        for (size_t h = 0; h < niveles.size(); h++) total += niveles[h].size();
+        return total;
+    }
+
+    size_t capacidadTotal() const {
+        size_t total = 0;
+        for (size_t h = 0; h < niveles.size(); h++) total += capacidad(h);
+        return total;
+    }
+
+    void agregar(unsigned int valor) {
+        if (niveles.empty()) agregarNivel();
+        niveles[0].push_back(valor);
+        n++;
+        tamano++;
+        while (tamano > limite) compactar();
+    }
+
+    void agregarNivel() {
+        niveles.emplace_back();
+        limite = capacidadTotal();
+    }
+
+    // Compacta el primer nivel que rebasó su capacidad
+    void compactar() {
+        for (size_t h = 0; h < niveles.size(); h++) {
+            if ((int)niveles[h].size() < capacidad(h)) continue;
+            if (h + 1 == niveles.size()) agregarNivel();
+
+            vector<unsigned int>& nivel = niveles[h];
+            sort(nivel.begin(), nivel.end());
+            moneda = mezclarHash(moneda);
+            size_t desplazamiento = moneda & 1;
+            size_t pares = nivel.size() & ~(size_t)1;
+            for (size_t i = desplazamiento; i < pares; i += 2) niveles[h + 1].push_back(nivel[i]);
+            // Si el nivel tenía un número impar de valores, el último se queda
+            if (nivel.size() & 1) nivel[0] = nivel.back();
+            nivel.resize(nivel.size() & 1);
+            tamano = guardados();
+            return;
+        }
+    }
+
+    void fusionar(const BocetoKLL& otro) {
+        while (niveles.size() < otro.niveles.size()) agregarNivel();
+        for (size_t h = 0; h < otro.niveles.size(); h++) {
+            niveles[h].insert(niveles[h].end(), otro.niveles[h].begin(), otro.niveles[h].end());
+        }
+        n += otro.n;
+        tamano = guardados();
+        while (tamano > limite) compactar();
+    }
+
+    // Valor aproximado en el cuantil q (0..1)
+    unsigned int cuantil(double q) const {
+        vector<pair<unsigned int, uint64_t>> pesados;
+        uint64_t pesoTotal = 0;
+        for (size_t h = 0; h < niveles.size(); h++) {
+            for (size_t i = 0; i < niveles[h].size(); i++) {
+                pesados.push_back(make_pair(niveles[h][i], 1ULL << h));
+                pesoTotal += 1ULL << h;
+            }
+        }
+        if (pesados.empty()) return 0;
+        sort(pesados.begin(), pesados.end());
+        uint64_t objetivo = (uint64_t)ceil(q * pesoTotal);
+        uint64_t acumulado = 0;
+        for (size_t i = 0; i < pesados.size(); i++) {
+            acumulado += pesados[i].second;
+            if (acumulado >= objetivo) return pesados[i].first;
+        }
+        return pesados.back().first;
+    }
+};
+
+// --- HYPERLOGLOG: DISTINTOS ---
+struct BocetoHLL {
+    unsigned char registros[REGISTROS_HLL];
+
+    BocetoHLL() { memset(registros, 0, sizeof(registros)); }
+
+    void agregar(uint64_t valor) {
+        uint64_t hash = mezclarHash(valor);
+        size_t indice = hash >> (64 - BITS_HLL);
+        uint64_t resto = hash << BITS_HLL;
+        unsigned char rango = resto == 0 ? 64 - BITS_HLL + 1 : __builtin_clzll(resto) + 1;
+        if (rango > registros[indice]) registros[indice] = rango;
+    }
+
+    void fusionar(const BocetoHLL& otro) {
+        for (int i = 0; i < REGISTROS_HLL; i++) registros[i] = max(registros[i], otro.registros[i]);
+    }
+
+    double estimar() const {
+        double m = REGISTROS_HLL;
+        double suma = 0;
+        int ceros = 0;
+        for (int i = 0; i < REGISTROS_HLL; i++) {
+            suma += ldexp(1.0, -registros[i]);
+            if (registros[i] == 0) ceros++;
+        }
+        double alfa = 0.7213 / (1 + 1.079 / m);
+        double estimado = alfa * m * m / suma;
+        // Pocos elementos: conteo lineal con los registros vacíos
+        if (estimado <= 2.5 * m && ceros > 0) estimado = m * log(m / ceros);
+        return estimado;
+    }
+};
+
+// Llave de un mes de un año en platillosPorMes: ordena por año y luego por mes
+inline int llaveMes(int anio, int mes) {
+    return anio * 12 + mes - 1;
+}
+
+// Bocetos que se guardan en cada vértice restaurante del grafo
+struct BocetosRestaurante {
+    BocetoKLL precios;
+    // Platillos distintos por (año, mes), ordenados por llaveMes; solo los meses con órdenes
+    vector<pair<int, BocetoHLL>> platillosPorMes;
+
+    // Boceto de un mes; la bitácora suele ir en orden, así que primero se revisa el último
+    BocetoHLL& deMes(int anio, int mes) {
+        int llave = llaveMes(anio, mes);
+        if (!platillosPorMes.empty() && platillosPorMes.back().first == llave) return platillosPorMes.back().second;
+        auto it = lower_bound(platillosPorMes.begin(), platillosPorMes.end(), llave,
+                              [](const pair<int, BocetoHLL>& entrada, int buscada) { return entrada.first < buscada; });
+        if (it == platillosPorMes.end() || it->first != llave) it = platillosPorMes.insert(it, make_pair(llave, BocetoHLL()));
+        return it->second;
+    }
+
+    // Platillos distintos en todo el periodo: fusión de los meses
+    double platillosDistintos() const {
+        BocetoHLL total;
+        for (size_t i = 0; i < platillosPorMes.size(); i++) total.fusionar(platillosPorMes[i].second);
+        return total.estimar();
+    }
+
+    void fusionar(const BocetosRestaurante& otro) {
+        precios.fusionar(otro.precios);
+        for (size_t i = 0; i < otro.platillosPorMes.size(); i++) {
+            deMes(otro.platillosPorMes[i].first / 12, otro.platillosPorMes[i].first % 12 + 1).fusionar(otro.platillosPorMes[i].second);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,128 @@
+/*
+CACHÉ DE RESULTADOS DE CONSULTAS
+Guarda los resultados de las búsquedas por rango y de las búsquedas de platillo (BFS)
+para no recalcularlas cuando el usuario repite la misma consulta:
+- LRU acotada por el número de líneas guardadas
+- La llave se normaliza a partir de los parámetros ya convertidos (fechas numéricas, ID del platillo)
+- El resultado se comparte: mostrarlo y guardarlo en archivo usan la misma copia
+- Cada lote nuevo es una época de ingesta; solo se invalidan las entradas que el lote
+  realmente toca (rangos que contienen alguna fecha del lote, platillos que aparecen en él)
+
+Autores: Equipo SProblema 5
+ - Franco Varela Villegas - A01199186
+ - Nerik Nieto Gutiérrez - A01739652
+ - Eduardo Mora Howard - A00829920
+*/
+
+#ifndef CACHE_CONSULTAS_H
+#define CACHE_CONSULTAS_H
+
+#include <string>
+#include <vector>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <cstdio>
+
+using namespace std;
+
+#define CAPACIDAD_CACHE_DEFECTO 100000 // líneas
+
+// Resultado de una consulta; solo se llena la parte que corresponde a su tipo
+struct ResultadoConsulta {
+    vector<string> lineas;                 // búsqueda por rango
+    vector<pair<int, int>> restaurantes;   // platillo: (ID restaurante, pedidos)
+};
+
+struct EntradaCache {
+    string llave;
+    char tipo;                     // 'R' = rango de fechas, 'P' = platillo
+    unsigned long int fechaInicio;
+    unsigned long int fechaFin;
+    int idPlatillo;
+    unsigned long int epoca;       // última época de ingesta con la que el resultado es válido
+    size_t costo;                  // líneas que ocupa
+    shared_ptr<const ResultadoConsulta> resultado;
+};
+
+struct CacheConsultas {
+    list<EntradaCache> entradas; // al frente la usada más recientemente
+    unordered_map<string, list<EntradaCache>::iterator> indice;
+    size_t capacidad = CAPACIDAD_CACHE_DEFECTO;
+    size_t usado = 0;
+    size_t aciertos = 0;
+    size_t fallos = 0;
+    size_t invalidadas = 0;
+
+    static string llaveRango(unsigned long int fechaInicio, unsigned long int fechaFin) {
+        char llave[64];
+        snprintf(llave, sizeof(llave), "R:%lu:%lu", fechaInicio, fechaFin);
+        return llave;
+    }
+
+    static string llavePlatillo(int idPlatillo) {
+        return "P:" + to_string(idPlatillo);
+    }
+
+    // Regresa el resultado guardado o nullptr; cuenta aciertos y fallos. Una entrada de
+    // una época anterior a 'epoca' no pasó por invalidarLote y ya no se puede usar
+    shared_ptr<const ResultadoConsulta> buscar(const string& llave, unsigned long int epoca) {
+        auto it = indice.find(llave);
+        if (it == indice.end()) {
+            fallos++;
+            return nullptr;
+        }
+        if (it->second->epoca < epoca) {
+            eliminar(it->second);
+            invalidadas++;
+            fallos++;
+            return nullptr;
+        }
+        aciertos++;
+        entradas.splice(entradas.begin(), entradas, it->second);
+        return it->second->resultado;
+    }
+
+    void guardar(const EntradaCache& entrada) {
+        if (capacidad == 0 || entrada.costo > capacidad) return;
+        auto it = indice.find(entrada.llave);
+        if (it != indice.end()) eliminar(it->second);
+
+        entradas.push_front(entrada);
+        indice[entrada.llave] = entradas.begin();
+        usado += entrada.costo;
+        while (usado > capacidad) eliminar(prev(entradas.end()));
+    }
+
+    // Un lote nuevo con fechas en [fechaMin, fechaMax] y los platillos marcados cambió los datos.
+    // Las entradas que no se ven afectadas pasan a la nueva época
+    void invalidarLote(unsigned long int fechaMin, unsigned long int fechaMax,
+                       const vector<bool>& platillosDelLote, unsigned long int epoca) {
+        auto it = entradas.begin();
+        while (it != entradas.end()) {
+            bool afectada;
+            if (it->tipo == 'R') {
+                afectada = it->fechaInicio <= fechaMax && fechaMin <= it->fechaFin;
+            } else {
+                afectada = it->idPlatillo < (int)platillosDelLote.size() && platillosDelLote[it->idPlatillo];
+            }
+            if (afectada) {
+                auto siguiente = next(it);
+                eliminar(it);
+                invalidadas++;
+                it = siguiente;
+            } else {
+                it->epoca = epoca;
+                ++it;
+            }
+        }
+    }
+
+    void eliminar(list<EntradaCache>::iterator it) {
+        usado -= it->costo;
+        indice.erase(it->llave);
+        entradas.erase(it);
+    }
+};
+
+#endif
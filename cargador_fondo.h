@@ -0,0 +1,139 @@
+/*
+CARGA EN SEGUNDO PLANO
+Permite mostrar el menú de inmediato mientras la bitácora se lee y procesa en otro hilo:
+- Mientras se ingiere, cada LINEAS_POR_AVANCE líneas se publica un resumen inmutable
+  (líneas, platillos y restaurantes vistos hasta ahora) que el menú puede leer sin esperar
+- La carga avanza por etapas; cada opción del menú espera solo la etapa que necesita
+  (el grafo está completo al terminar la ingesta; el orden por fecha, al final)
+- Mientras una opción espera se muestra el avance
+- El hilo de carga no imprime: sus errores se guardan y el menú los muestra
+
+Autores: Equipo SProblema 5
+ - Franco Varela Villegas - A01199186
+ - Nerik Nieto Gutiérrez - A01739652
+ - Eduardo Mora Howard - A00829920
+*/
+
+#ifndef CARGADOR_FONDO_H
+#define CARGADOR_FONDO_H
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <chrono>
+
+#include "nucleo.h"
+
+using namespace std;
+
+// Etapas en el orden en que se completan
+#define ETAPA_INGIRIENDO 0  // columnas, frecuencias y grafo creciendo
+#define ETAPA_ORDENANDO  1  // grafo, frecuencias y bocetos completos; falta el orden por fecha
+#define ETAPA_LISTO      2  // todo construido
+
+// Lo que se sabe de la carga en un momento dado; nunca se modifica después de publicarse
+struct ResumenCarga {
+    size_t bytesProcesados = 0;
+    int lineasLeidas = 0;
+    int lineasInvalidas = 0;
+    vector<string> platillos;
+    vector<string> restaurantes;
+};
+
+struct CargadorFondo {
+    thread hilo;
+    mutex candado;
+    condition_variable aviso;
+    int etapa = ETAPA_INGIRIENDO;   // protegido por 'candado'
+    size_t bytesTotales = 0;
+    vector<string> errores;         // protegido por 'candado'; el menú los imprime
+    shared_ptr<const ResumenCarga> resumen = make_shared<ResumenCarga>();
+
+    CargadorFondo() {}
+    CargadorFondo(const CargadorFondo&) = delete;
+    CargadorFondo& operator=(const CargadorFondo&) = delete;
+
+    ~CargadorFondo() {
+        if (hilo.joinable()) hilo.join();
+    }
+
+    void iniciar(function<void()> trabajo) {
+        hilo = thread(trabajo);
+    }
+
+    // Se llaman desde el hilo de carga
+    void publicar(shared_ptr<const ResumenCarga> nuevo) {
+        lock_guard<mutex> guardia(candado);
+        resumen = nuevo;
+    }
+
+    void avanzarEtapa(int nueva) {
+        {
+            lock_guard<mutex> guardia(candado);
+            etapa = nueva;
+        }
+        aviso.notify_all();
+    }
+
+    void reportarError(const string& mensaje) {
+        lock_guard<mutex> guardia(candado);
+        errores.push_back(mensaje);
+    }
+
+    // Se llaman desde el hilo del menú
+    vector<string> tomarErrores() {
+        lock_guard<mutex> guardia(candado);
+        vector<string> pendientes;
+        pendientes.swap(errores);
+        return pendientes;
+    }
+
+    shared_ptr<const ResumenCarga> ultimoResumen() {
+        lock_guard<mutex> guardia(candado);
+        return resumen;
+    }
+
+    int etapaActual() {
+        lock_guard<mutex> guardia(candado);
+        return etapa;
+    }
+
+    // Bloquea hasta alcanzar 'necesaria' mostrando el avance cada cuarto de segundo
+    void esperar(int necesaria) {
+        unique_lock<mutex> guardia(candado);
+        if (etapa >= necesaria) return;
+        while (etapa < necesaria) {
+            cout << "\rEsperando a que termine la carga... " << descripcion(etapa, resumen->bytesProcesados) << "   " << flush;
+            aviso.wait_for(guardia, chrono::milliseconds(250));
+        }
+        cout << "\r" << string(70, ' ') << "\r" << flush;
+    }
+
+    // Texto corto con la etapa y el porcentaje leído
+    string descripcion(int etapaActual, size_t bytesProcesados) const {
+        if (etapaActual == ETAPA_LISTO) return "carga completa";
+        if (etapaActual == ETAPA_ORDENANDO) return "ordenando por fecha";
+        int porcentaje = bytesTotales > 0 ? (int)(100.0 * bytesProcesados / bytesTotales) : 0;
+        return "ingiriendo " + to_string(porcentaje) + "%";
+    }
+
+    string estado() {
+        lock_guard<mutex> guardia(candado);
+        return descripcion(etapa, resumen->bytesProcesados);
+    }
+};
+
+// Arma el resumen a partir del motor; se llama desde el hilo de carga, que es dueño del motor
+inline shared_ptr<const ResumenCarga> resumirCarga(const Motor& motor, size_t bytesProcesados) {
+    shared_ptr<ResumenCarga> resumen = make_shared<ResumenCarga>();
+    resumen->bytesProcesados = bytesProcesados;
+    resumen->lineasLeidas = motor.lineasLeidas;
+    resumen->lineasInvalidas = motor.lineasInvalidas;
+    resumen->platillos = motor.platillos.nombres;
+    resumen->restaurantes = motor.restaurantes.nombres;
+    return resumen;
+}
+
+#endif
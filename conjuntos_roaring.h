@@ -0,0 +1,264 @@
+/*
+CONJUNTOS COMPRIMIDOS ESTILO ROARING
+Para preguntas como "qué restaurantes sirven A y B" sin recorrer listas enlazadas una y
+otra vez, cada platillo guarda el conjunto de sus restaurantes (y cada restaurante el de
+sus platillos) como un bitmap comprimido:
+- Los IDs se parten en su parte alta (16 bits) y baja (16 bits); cada parte alta tiene un contenedor
+- Un contenedor con pocos valores es un arreglo ordenado de uint16 (hasta LIMITE_ARREGLO);
+  con más, es un bitmap de 2^16 bits (1024 palabras de 64 bits)
+- Intersección, unión y diferencia trabajan contenedor por contenedor: entre bitmaps son
+  operaciones palabra por palabra (64 IDs por instrucción) y entre arreglos son mezclas
+- La cardinalidad de cada contenedor se guarda, así contar el resultado no recorre nada
+
+Autores: Equipo SProblema 5
+ - Franco Varela Villegas - A01199186
+ - Nerik Nieto Gutiérrez - A01739652
+ - Eduardo Mora Howard - A00829920
+*/
+
+#ifndef CONJUNTOS_ROARING_H
+#define CONJUNTOS_ROARING_H
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+
+#define LIMITE_ARREGLO 4096          // más valores que esto y el contenedor pasa a bitmap
+#define PALABRAS_CONTENEDOR 1024     // 2^16 bits / 64
+
+// Valores con la misma parte alta
+struct Contenedor {
+    uint16_t alto;
+    int cardinalidad;
+    vector<uint16_t> arreglo;    // contenedor disperso: valores bajos ordenados
+    vector<uint64_t> bits;       // contenedor denso: si no está vacío, este es el que vale
+
+    Contenedor(uint16_t parteAlta) {
+        alto = parteAlta;
+        cardinalidad = 0;
+    }
+
+    bool esBitmap() const { return !bits.empty(); }
+
+    bool contiene(uint16_t bajo) const {
+        if (esBitmap()) return (bits[bajo >> 6] >> (bajo & 63)) & 1;
+        return binary_search(arreglo.begin(), arreglo.end(), bajo);
+    }
+
+    void agregar(uint16_t bajo) {
+        if (esBitmap()) {
+            uint64_t bit = 1ULL << (bajo & 63);
+            if (!(bits[bajo >> 6] & bit)) {
+                bits[bajo >> 6] |= bit;
+                cardinalidad++;
+            }
+            return;
+        }
+        auto pos = lower_bound(arreglo.begin(), arreglo.end(), bajo);
+        if (pos != arreglo.end() && *pos == bajo) return;
+        arreglo.insert(pos, bajo);
+        cardinalidad++;
+        if (cardinalidad > LIMITE_ARREGLO) aBitmap();
+    }
+
+    void aBitmap() {
+        bits.assign(PALABRAS_CONTENEDOR, 0);
+        for (size_t i = 0; i < arreglo.size(); i++) bits[arreglo[i] >> 6] |= 1ULL << (arreglo[i] & 63);
+        vector<uint16_t>().swap(arreglo);
+    }
+
+    void aArreglo() {
+        arreglo.clear();
+        for (int w = 0; w < PALABRAS_CONTENEDOR; w++) {
+            uint64_t palabra = bits[w];
+            while (palabra != 0) {
+                arreglo.push_back(w * 64 + __builtin_ctzll(palabra));
+                palabra &= palabra - 1;
+            }
+        }
+        vector<uint64_t>().swap(bits);
+    }
+
+    // Después de una operación entre bitmaps: recuenta y baja a arreglo si quedó disperso
+    void normalizar() {
+        if (!esBitmap()) {
+            cardinalidad = arreglo.size();
+            return;
+        }
+        cardinalidad = 0;
+        for (int w = 0; w < PALABRAS_CONTENEDOR; w++) cardinalidad += __builtin_popcountll(bits[w]);
+        if (cardinalidad <= LIMITE_ARREGLO) aArreglo();
+    }
+
+    template <typename F>
+    void recorrer(F visitar) const {
+        uint32_t base = (uint32_t)alto << 16;
+        if (!esBitmap()) {
+            for (size_t i = 0; i < arreglo.size(); i++) visitar(base | arreglo[i]);
+            return;
+        }
+        for (int w = 0; w < PALABRAS_CONTENEDOR; w++) {
+            uint64_t palabra = bits[w];
+            while (palabra != 0) {
+                visitar(base | (w * 64 + __builtin_ctzll(palabra)));
+                palabra &= palabra - 1;
+            }
+        }
+    }
+};
+
+// --- OPERACIONES ENTRE CONTENEDORES (misma parte alta) ---
+
+inline Contenedor interseccionContenedores(const Contenedor& a, const Contenedor& b) {
+    Contenedor r(a.alto);
+    if (a.esBitmap() && b.esBitmap()) {
+        r.bits.resize(PALABRAS_CONTENEDOR);
+        for (int w = 0; w < PALABRAS_CONTENEDOR; w++) r.bits[w] = a.bits[w] & b.bits[w];
+    } else if (a.esBitmap() || b.esBitmap()) {
+        const Contenedor& disperso = a.esBitmap() ? b : a;
+        const Contenedor& denso = a.esBitmap() ? a : b;
+        for (size_t i = 0; i < disperso.arreglo.size(); i++) {
+            if (denso.contiene(disperso.arreglo[i])) r.arreglo.push_back(disperso.arreglo[i]);
+        }
+    } else {
+        set_intersection(a.arreglo.begin(), a.arreglo.end(), b.arreglo.begin(), b.arreglo.end(), back_inserter(r.arreglo));
+    }
+    r.normalizar();
+    return r;
+}
+
+inline Contenedor unionContenedores(const Contenedor& a, const Contenedor& b) {
+    Contenedor r(a.alto);
+    if (a.esBitmap() || b.esBitmap()) {
+        r.bits.assign(PALABRAS_CONTENEDOR, 0);
+        const Contenedor* lados[2] = {&a, &b};
+        for (int l = 0; l < 2; l++) {
+            if (lados[l]->esBitmap()) {
+                for (int w = 0; w < PALABRAS_CONTENEDOR; w++) r.bits[w] |= lados[l]->bits[w];
+            } else {
+                for (size_t i = 0; i < lados[l]->arreglo.size(); i++) {
+                    uint16_t v = lados[l]->arreglo[i];
+                    r.bits[v >> 6] |= 1ULL << (v & 63);
+                }
+            }
+        }
+        r.normalizar();
+        return r;
+    }
+    set_union(a.arreglo.begin(), a.arreglo.end(), b.arreglo.begin(), b.arreglo.end(), back_inserter(r.arreglo));
+    r.cardinalidad = r.arreglo.size();
+    if (r.cardinalidad > LIMITE_ARREGLO) r.aBitmap();
+    return r;
+}
+
+inline Contenedor diferenciaContenedores(const Contenedor& a, const Contenedor& b) {
+    Contenedor r(a.alto);
+    if (a.esBitmap()) {
+        r.bits = a.bits;
+        if (b.esBitmap()) {
+            for (int w = 0; w < PALABRAS_CONTENEDOR; w++) r.bits[w] &= ~b.bits[w];
+        } else {
+            for (size_t i = 0; i < b.arreglo.size(); i++) r.bits[b.arreglo[i] >> 6] &= ~(1ULL << (b.arreglo[i] & 63));
+        }
+    } else if (b.esBitmap()) {
+        for (size_t i = 0; i < a.arreglo.size(); i++) {
+            if (!b.contiene(a.arreglo[i])) r.arreglo.push_back(a.arreglo[i]);
+        }
+    } else {
+        set_difference(a.arreglo.begin(), a.arreglo.end(), b.arreglo.begin(), b.arreglo.end(), back_inserter(r.arreglo));
+    }
+    r.normalizar();
+    return r;
+}
+
+// --- BITMAP COMPLETO ---
+
+struct BitmapRoaring {
+    vector<Contenedor> contenedores; // ordenados por parte alta, ninguno vacío
+
+    void agregar(uint32_t valor) {
+        uint16_t alto = valor >> 16;
+        auto pos = lower_bound(contenedores.begin(), contenedores.end(), alto,
+            [](const Contenedor& c, uint16_t a) { return c.alto < a; });
+        if (pos == contenedores.end() || pos->alto != alto) pos = contenedores.insert(pos, Contenedor(alto));
+        pos->agregar(valor & 0xFFFF);
+    }
+
+    bool contiene(uint32_t valor) const {
+        uint16_t alto = valor >> 16;
+        auto pos = lower_bound(contenedores.begin(), contenedores.end(), alto,
+            [](const Contenedor& c, uint16_t a) { return c.alto < a; });
+        return pos != contenedores.end() && pos->alto == alto && pos->contiene(valor & 0xFFFF);
+    }
+
+    size_t cardinalidad() const {
+        size_t total = 0;
+        for (size_t i = 0; i < contenedores.size(); i++) total += contenedores[i].cardinalidad;
+        return total;
+    }
+
+    vector<uint32_t> valores() const {
+        vector<uint32_t> resultado;
+        for (size_t i = 0; i < contenedores.size(); i++) {
+            contenedores[i].recorrer([&resultado](uint32_t v) { resultado.push_back(v); });
+        }
+        return resultado;
+    }
+
+    size_t bytesUsados() const {
+        size_t total = contenedores.size() * sizeof(Contenedor);
+        for (size_t i = 0; i < contenedores.size(); i++) {
+            total += contenedores[i].arreglo.size() * sizeof(uint16_t) + contenedores[i].bits.size() * sizeof(uint64_t);
+        }
+        return total;
+    }
+
+    // Las tres operaciones recorren los contenedores de los dos lados como una mezcla
+    static BitmapRoaring interseccion(const BitmapRoaring& a, const BitmapRoaring& b) {
+        BitmapRoaring r;
+        size_t i = 0, j = 0;
+        while (i < a.contenedores.size() && j < b.contenedores.size()) {
+            if (a.contenedores[i].alto < b.contenedores[j].alto) i++;
+            else if (b.contenedores[j].alto < a.contenedores[i].alto) j++;
+            else {
+                Contenedor c = interseccionContenedores(a.contenedores[i++], b.contenedores[j++]);
+                if (c.cardinalidad > 0) r.contenedores.push_back(move(c));
+            }
+        }
+        return r;
+    }
+
+    static BitmapRoaring unir(const BitmapRoaring& a, const BitmapRoaring& b) {
+        BitmapRoaring r;
+        size_t i = 0, j = 0;
+        while (i < a.contenedores.size() || j < b.contenedores.size()) {
+            if (j == b.contenedores.size() || (i < a.contenedores.size() && a.contenedores[i].alto < b.contenedores[j].alto)) {
+                r.contenedores.push_back(a.contenedores[i++]);
+            } else if (i == a.contenedores.size() || b.contenedores[j].alto < a.contenedores[i].alto) {
+                r.contenedores.push_back(b.contenedores[j++]);
+            } else {
+                r.contenedores.push_back(unionContenedores(a.contenedores[i++], b.contenedores[j++]));
+            }
+        }
+        return r;
+    }
+
+    static BitmapRoaring diferencia(const BitmapRoaring& a, const BitmapRoaring& b) {
+        BitmapRoaring r;
+        size_t j = 0;
+        for (size_t i = 0; i < a.contenedores.size(); i++) {
+            while (j < b.contenedores.size() && b.contenedores[j].alto < a.contenedores[i].alto) j++;
+            if (j < b.contenedores.size() && b.contenedores[j].alto == a.contenedores[i].alto) {
+                Contenedor c = diferenciaContenedores(a.contenedores[i], b.contenedores[j]);
+                if (c.cardinalidad > 0) r.contenedores.push_back(move(c));
+            } else {
+                r.contenedores.push_back(a.contenedores[i]);
+            }
+        }
+        return r;
+    }
+};
+
+#endif
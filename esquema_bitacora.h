@@ -0,0 +1,222 @@
+/*
+ESQUEMA DE CAMPOS DE LA BITÁCORA
+El formato de una línea se declara como un tipo: una lista de campos que el compilador
+convierte en código seguido (un campo tras otro, sin tabla que interpretar en cada línea).
+Cada campo es una estructura con un extraer() inline que avanza el puntero y guarda su
+valor en una posición fija de ValoresLinea; Esquema<...> los encadena con && así que la
+primera falla corta la línea.
+
+Campos disponibles:
+- Mes<C>              tres letras del mes (hash perfecto de marca_tiempo.h)
+- Entero<C>           dígitos decimales (hasta MAX_DIGITOS_CAMPO)
+- Literal<'x', ...>   esos caracteres exactamente
+- Espacios            salta los espacios que haya (puede no haber ninguno)
+- SaltarHasta<...>    avanza hasta después de la primera aparición del texto
+- TextoHasta<C, ...>  nombre hasta el texto dado (sin espacios en las orillas)
+- TextoHastaUltimo<C, 'x'>  nombre hasta la última aparición del carácter
+- FinLinea            ya no queda nada en la línea
+
+Otro formato se declara igual; al final del archivo está EsquemaBarras
+("07/02 17:08:30 | El Barzon | Fideua | 140", --formato barras). Los campos son constexpr,
+así que cada esquema se prueba con una línea de ejemplo en un static_assert.
+
+Autores: Equipo SProblema 5
+ - Franco Varela Villegas - A01199186
+ - Nerik Nieto Gutiérrez - A01739652
+ - Eduardo Mora Howard - A00829920
+*/
+
+#ifndef ESQUEMA_BITACORA_H
+#define ESQUEMA_BITACORA_H
+
+#include "marca_tiempo.h"
+
+using namespace std;
+
+// Posiciones de los valores numéricos dentro de ValoresLinea::numeros
+#define CAMPO_MES 0
+#define CAMPO_DIA 1
+#define CAMPO_HORAS 2
+#define CAMPO_MINUTOS 3
+#define CAMPO_SEGUNDOS 4
+#define CAMPO_PRECIO 5
+#define NUM_CAMPOS_NUMERICOS 6
+
+// Posiciones de los nombres dentro de ValoresLinea::textos
+#define CAMPO_RESTAURANTE 0
+#define CAMPO_PLATILLO 1
+#define NUM_CAMPOS_TEXTO 2
+
+#define MAX_DIGITOS_CAMPO 9 // como leerDigitos: cualquier número de 9 dígitos cabe en un int
+
+// Lo que extrae un esquema; los campos que el formato no trae se quedan en 0
+struct ValoresLinea {
+    int numeros[NUM_CAMPOS_NUMERICOS] = {0};
+    const char* textos[NUM_CAMPOS_TEXTO] = {nullptr};
+    int largos[NUM_CAMPOS_TEXTO] = {0};
+};
+
+// Formatos de línea que acepta --formato
+#define FORMATO_BITACORA 0
+#define FORMATO_BARRAS 1
+
+// --- CAMPOS ---
+
+// strstr y strrchr no son constexpr: estas sí, para poder probar los esquemas al compilar
+constexpr const char* buscarTexto(const char* p, const char* texto) {
+    for (; *p != '\0'; p++) {
+        int i = 0;
+        while (texto[i] != '\0' && p[i] == texto[i]) i++;
+        if (texto[i] == '\0') return p;
+    }
+    return nullptr;
+}
+
+constexpr const char* buscarUltimo(const char* p, char c) {
+    const char* ultimo = nullptr;
+    for (; *p != '\0'; p++) {
+        if (*p == c) ultimo = p;
+    }
+    return ultimo;
+}
+
+template <int C>
+struct Mes {
+    static constexpr bool extraer(const char*& p, ValoresLinea& v) {
+        int mes = numeroMes(p);
+        v.numeros[C] = mes;
+        p += 3;
+        return mes != 0;
+    }
+};
+
+template <int C>
+struct Entero {
+    static constexpr bool extraer(const char*& p, ValoresLinea& v) {
+        int valor = 0, digitos = 0;
+        while (*p >= '0' && *p <= '9') {
+            if (++digitos > MAX_DIGITOS_CAMPO) return false;
+            valor = valor * 10 + (*p++ - '0');
+        }
+        v.numeros[C] = valor;
+        return digitos > 0;
+    }
+};
+
+template <char... Caracteres>
+struct Literal {
+    static constexpr bool extraer(const char*& p, ValoresLinea&) {
+        return ((*p++ == Caracteres) && ...);
+    }
+};
+
+struct Espacios {
+    static constexpr bool extraer(const char*& p, ValoresLinea&) {
+        while (*p == ' ') p++;
+        return true;
+    }
+};
+
+struct FinLinea {
+    static constexpr bool extraer(const char*& p, ValoresLinea&) {
+        return *p == '\0';
+    }
+};
+
+template <char... Caracteres>
+struct SaltarHasta {
+    static constexpr char texto[sizeof...(Caracteres) + 1] = {Caracteres..., '\0'};
+
+    static constexpr bool extraer(const char*& p, ValoresLinea&) {
+        const char* encontrado = buscarTexto(p, texto);
+        if (encontrado == nullptr) return false;
+        p = encontrado + sizeof...(Caracteres);
+        return true;
+    }
+};
+
+// Guarda [inicio, fin) sin los espacios de las orillas
+constexpr void guardarTexto(ValoresLinea& v, int campo, const char* inicio, const char* fin) {
+    while (inicio < fin && *inicio == ' ') inicio++;
+    while (fin > inicio && fin[-1] == ' ') fin--;
+    v.textos[campo] = inicio;
+    v.largos[campo] = fin - inicio;
+}
+
+template <int C, char... Terminador>
+struct TextoHasta {
+    static constexpr char texto[sizeof...(Terminador) + 1] = {Terminador..., '\0'};
+
+    static constexpr bool extraer(const char*& p, ValoresLinea& v) {
+        const char* fin = buscarTexto(p, texto);
+        if (fin == nullptr) return false;
+        guardarTexto(v, C, p, fin);
+        p = fin + sizeof...(Terminador);
+        return v.largos[C] > 0;
+    }
+};
+
+template <int C, char Terminador>
+struct TextoHastaUltimo {
+    static constexpr bool extraer(const char*& p, ValoresLinea& v) {
+        const char* fin = buscarUltimo(p, Terminador);
+        if (fin == nullptr) return false;
+        guardarTexto(v, C, p, fin);
+        p = fin + 1;
+        return v.largos[C] > 0;
+    }
+};
+
+// --- ESQUEMA ---
+
+template <typename... Campos>
+struct Esquema {
+    static constexpr bool extraer(const char* linea, ValoresLinea& v) {
+        const char* p = linea;
+        return (Campos::extraer(p, v) && ...);
+    }
+};
+
+// "Feb 13 19:25:24 R:El Barzon O:ensalada Griega(140) "
+using EsquemaBitacora = Esquema<
+    Mes<CAMPO_MES>, Literal<' '>, Entero<CAMPO_DIA>, Literal<' '>,
+    Entero<CAMPO_HORAS>, Literal<':'>, Entero<CAMPO_MINUTOS>, Literal<':'>, Entero<CAMPO_SEGUNDOS>,
+    SaltarHasta<'R', ':'>, TextoHasta<CAMPO_RESTAURANTE, ' ', 'O', ':'>,
+    TextoHastaUltimo<CAMPO_PLATILLO, '('>, Entero<CAMPO_PRECIO>, Literal<')'>>;
+
+// "07/02 17:08:30 | El Barzon | Fideua | 140"
+using EsquemaBarras = Esquema<
+    Entero<CAMPO_DIA>, Literal<'/'>, Entero<CAMPO_MES>, Literal<' '>,
+    Entero<CAMPO_HORAS>, Literal<':'>, Entero<CAMPO_MINUTOS>, Literal<':'>, Entero<CAMPO_SEGUNDOS>,
+    Literal<' ', '|'>, TextoHasta<CAMPO_RESTAURANTE, ' ', '|'>, TextoHasta<CAMPO_PLATILLO, ' ', '|'>,
+    Espacios, Entero<CAMPO_PRECIO>, Espacios, FinLinea>;
+
+// --- PRUEBAS AL COMPILAR ---
+
+// Valores de una línea de ejemplo; si el esquema la rechaza el mes queda en 0
+template <typename EsquemaLinea>
+constexpr ValoresLinea extraerEjemplo(const char* linea) {
+    ValoresLinea v;
+    if (!EsquemaLinea::extraer(linea, v)) v.numeros[CAMPO_MES] = 0;
+    return v;
+}
+
+constexpr ValoresLinea EJEMPLO_BITACORA = extraerEjemplo<EsquemaBitacora>("Feb 13 19:25:24 R:El Barzon O:ensalada Griega(140) ");
+static_assert(EJEMPLO_BITACORA.numeros[CAMPO_MES] == 2 && EJEMPLO_BITACORA.numeros[CAMPO_DIA] == 13
+              && EJEMPLO_BITACORA.numeros[CAMPO_SEGUNDOS] == 24 && EJEMPLO_BITACORA.numeros[CAMPO_PRECIO] == 140
+              && EJEMPLO_BITACORA.largos[CAMPO_RESTAURANTE] == 9 && EJEMPLO_BITACORA.largos[CAMPO_PLATILLO] == 15,
+              "EsquemaBitacora no separa bien la línea de ejemplo");
+
+constexpr ValoresLinea EJEMPLO_BARRAS = extraerEjemplo<EsquemaBarras>("07/02 17:08:30 | El Barzon | Fideua | 140");
+static_assert(EJEMPLO_BARRAS.numeros[CAMPO_MES] == 2 && EJEMPLO_BARRAS.numeros[CAMPO_DIA] == 7
+              && EJEMPLO_BARRAS.numeros[CAMPO_SEGUNDOS] == 30 && EJEMPLO_BARRAS.numeros[CAMPO_PRECIO] == 140
+              && EJEMPLO_BARRAS.largos[CAMPO_RESTAURANTE] == 9 && EJEMPLO_BARRAS.largos[CAMPO_PLATILLO] == 6,
+              "EsquemaBarras no separa bien la línea de ejemplo");
+
+// Las líneas mal formadas se rechazan: basura al final o un número que no cabe en un int
+static_assert(extraerEjemplo<EsquemaBarras>("07/02 17:08:30 | El Barzon | Fideua | 140 xx").numeros[CAMPO_MES] == 0
+              && extraerEjemplo<EsquemaBarras>("07/02 17:08:30 | El Barzon | Fideua | 9999999999").numeros[CAMPO_MES] == 0
+              && extraerEjemplo<EsquemaBitacora>("Feb 13 19:25:24 R:El Barzon O:Sopa(9999999999)").numeros[CAMPO_MES] == 0,
+              "Los esquemas aceptan una línea mal formada");
+
+#endif
@@ -0,0 +1,528 @@
+/*
+INGESTA POR FRAGMENTOS (UNA BITÁCORA POR DÍA O POR SUCURSAL)
+Cada archivo de la bitácora es un fragmento que se procesa por separado:
+- Cada fragmento arma su propio diccionario, grafo parcial, tabla de frecuencias,
+  corrida ordenada por fecha y bocetos de precios; varios fragmentos se procesan a la vez
+- El resultado parcial se guarda junto a la bitácora en 'archivo.frag'. Si la bitácora no
+  cambió (mismo tamaño y fecha de modificación al nanosegundo) la próxima carga lee el .frag
+  y no la vuelve a parsear
+- La fusión combina los fragmentos en las estructuras globales: reasigna los IDs de los
+  diccionarios, suma pesos de aristas y frecuencias, fusiona los bocetos y mezcla las corridas
+Agregar un día de datos es procesar un fragmento y volver a fusionar, no releer la historia.
+El resultado es el mismo que leer todos los archivos uno detrás de otro.
+Con --inferir-anio el año se hereda en el orden de los archivos: cada fragmento empieza con el
+estado del calendario (año y último mes) con el que terminó el anterior, igual que si se leyeran
+concatenados. Los fragmentos se procesan en paralelo suponiendo que empiezan sin mes anterior;
+después se recorren en orden y solo se vuelven a parsear los que con el estado real darían otro
+resultado (en la práctica, los que quedan después de un cambio de año). El .frag guarda el estado
+con el que empezó y terminó.
+
+Autores: Equipo SProblema 5
+ - Franco Varela Villegas - A01199186
+ - Nerik Nieto Gutiérrez - A01739652
+ - Eduardo Mora Howard - A00829920
+*/
+
+#ifndef FRAGMENTOS_H
+#define FRAGMENTOS_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <sys/stat.h>
+#include <dirent.h>
+
+#include "nucleo.h"
+
+using namespace std;
+
+#define MAGIA_FRAGMENTO "SPFRAG4" // fechas en segundos, estado del calendario y formato de línea
+#define EXTENSION_FRAGMENTO ".frag"
+#define MAX_NIVELES_KLL 64 // cada nivel de un KLL resume el doble de órdenes que el anterior
+
+// Resultado parcial de un archivo de la bitácora. Los IDs son locales al fragmento
+struct Fragmento {
+    string ruta;                       // bitácora de origen
+    long long tamanoOrigen = 0;        // para saber si el .frag sigue vigente
+    long long modificadoOrigen = 0;    // nanosegundos
+    int formato = FORMATO_BITACORA;    // esquema con el que se separaron las líneas (--formato)
+    // Calendario con el que se parseó: estado al empezar y al terminar
+    int inferirAnio = 0;
+    int anioInicial = ANIO_BASE_DEFECTO;
+    int mesInicial = 0;
+    int primerMes = 0;
+    int fechasInexistentes = 0;
+    int anioFinal = ANIO_BASE_DEFECTO;
+    int mesFinal = 0;
+    bool reutilizado = false;          // se leyó del .frag en lugar de parsear
+    int lineasLeidas = 0;
+    int lineasInvalidas = 0;
+    vector<string> restaurantes;
+    vector<string> platillos;
+
+    // Corrida: las órdenes válidas ya ordenadas por fecha
+    vector<unsigned long int> fechas;
+    vector<int> idRestaurante;
+    vector<int> idPlatillo;
+    vector<unsigned int> precios;
+    vector<size_t> inicioLinea;        // dentro de 'texto'
+    string texto;                      // líneas originales terminadas en '\0', en el orden de la corrida
+
+    vector<int> frecuenciaPlatillo;
+    vector<vector<pair<int, int>>> aristas; // por platillo: (restaurante, peso) de la más vieja a la más nueva
+    vector<BocetoKLL> preciosRestaurante;
+    vector<BocetoKLL> preciosPlatillo;
+};
+
+// --- ARCHIVOS ---
+
+// Tamaño y fecha de modificación (en nanosegundos) de un archivo. Regresa false si no existe.
+// Con segundos enteros, reescribir la bitácora con el mismo tamaño en el mismo segundo
+// dejaba vigente el .frag viejo
+inline bool datosArchivo(const string& ruta, long long& tamano, long long& modificado) {
+    struct stat info;
+    if (stat(ruta.c_str(), &info) != 0) return false;
+    tamano = info.st_size;
+    modificado = (long long)info.st_mtim.tv_sec * 1000000000LL + info.st_mtim.tv_nsec;
+    return true;
+}
+
+inline bool terminaEn(const string& texto, const char* sufijo) {
+    size_t len = strlen(sufijo);
+    return texto.size() >= len && texto.compare(texto.size() - len, len, sufijo) == 0;
+}
+
+// Agrega a 'rutas' el archivo o, si es un directorio, sus archivos (sin los .frag) en orden alfabético
+inline bool listarBitacoras(const char* ruta, vector<string>& rutas) {
+    struct stat info;
+    if (stat(ruta, &info) != 0) return false;
+    if (!S_ISDIR(info.st_mode)) {
+        rutas.push_back(ruta);
+        return true;
+    }
+    DIR* directorio = opendir(ruta);
+    if (directorio == nullptr) return false;
+    vector<string> encontrados;
+    struct dirent* entrada;
+    while ((entrada = readdir(directorio)) != nullptr) {
+        string nombre = entrada->d_name;
+        if (nombre[0] == '.' || terminaEn(nombre, EXTENSION_FRAGMENTO)) continue;
+        string completa = string(ruta) + "/" + nombre;
+        if (stat(completa.c_str(), &info) == 0 && S_ISREG(info.st_mode)) encontrados.push_back(completa);
+    }
+    closedir(directorio);
+    sort(encontrados.begin(), encontrados.end());
+    rutas.insert(rutas.end(), encontrados.begin(), encontrados.end());
+    return true;
+}
+
+// --- SERIALIZACIÓN ---
+// Formato binario: la magia, los datos del origen y luego cada campo con su tamaño al frente
+
+template <typename T>
+inline void escribirValor(ofstream& archivo, const T& valor) {
+    archivo.write((const char*)&valor, sizeof(T));
+}
+
+// Lee un .frag llevando la cuenta de los bytes que quedan: un tamaño dañado se detecta
+// antes de pedir memoria, en lugar de reservar lo que diga el archivo
+struct LectorFragmento {
+    ifstream archivo;
+    uint64_t restantes = 0;
+
+    bool abrir(const string& ruta) {
+        archivo.open(ruta, ios::binary | ios::ate);
+        if (!archivo.is_open()) return false;
+        restantes = archivo.tellg();
+        archivo.seekg(0, ios::beg);
+        return true;
+    }
+
+    bool leer(void* destino, uint64_t bytes) {
+        if (bytes > restantes || !archivo.read((char*)destino, bytes)) return false;
+        restantes -= bytes;
+        return true;
+    }
+
+    // ¿Caben 'n' elementos de 'tamano' bytes en lo que falta del archivo?
+    bool caben(uint64_t n, size_t tamano) const {
+        return n <= restantes / tamano;
+    }
+};
+
+template <typename T>
+inline bool leerValor(LectorFragmento& lector, T& valor) {
+    return lector.leer(&valor, sizeof(T));
+}
+
+template <typename T>
+inline void escribirArreglo(ofstream& archivo, const vector<T>& datos) {
+    escribirValor(archivo, (uint64_t)datos.size());
+    if (!datos.empty()) archivo.write((const char*)datos.data(), datos.size() * sizeof(T));
+}
+
+template <typename T>
+inline bool leerArreglo(LectorFragmento& lector, vector<T>& datos) {
+    uint64_t n;
+    if (!leerValor(lector, n) || !lector.caben(n, sizeof(T))) return false;
+    datos.resize(n);
+    return n == 0 || lector.leer(datos.data(), n * sizeof(T));
+}
+
+inline void escribirCadena(ofstream& archivo, const string& cadena) {
+    escribirValor(archivo, (uint64_t)cadena.size());
+    archivo.write(cadena.data(), cadena.size());
+}
+
+inline bool leerCadena(LectorFragmento& lector, string& cadena) {
+    uint64_t n;
+    if (!leerValor(lector, n) || !lector.caben(n, 1)) return false;
+    cadena.resize(n);
+    return n == 0 || lector.leer(&cadena[0], n);
+}
+
+inline void escribirNombres(ofstream& archivo, const vector<string>& nombres) {
+    escribirValor(archivo, (uint64_t)nombres.size());
+    for (size_t i = 0; i < nombres.size(); i++) escribirCadena(archivo, nombres[i]);
+}
+
+inline bool leerNombres(LectorFragmento& lector, vector<string>& nombres) {
+    uint64_t n;
+    if (!leerValor(lector, n) || !lector.caben(n, sizeof(uint64_t))) return false; // cada nombre trae su tamaño
+    nombres.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        if (!leerCadena(lector, nombres[i])) return false;
+    }
+    return true;
+}
+
+inline void escribirBocetos(ofstream& archivo, const vector<BocetoKLL>& bocetos) {
+    escribirValor(archivo, (uint64_t)bocetos.size());
+    for (size_t i = 0; i < bocetos.size(); i++) {
+        escribirValor(archivo, (uint64_t)bocetos[i].n);
+        escribirValor(archivo, (uint64_t)bocetos[i].niveles.size());
+        for (size_t h = 0; h < bocetos[i].niveles.size(); h++) escribirArreglo(archivo, bocetos[i].niveles[h]);
+    }
+}
+
+inline bool leerBocetos(LectorFragmento& lector, vector<BocetoKLL>& bocetos) {
+    uint64_t n;
+    if (!leerValor(lector, n) || !lector.caben(n, 2 * sizeof(uint64_t))) return false;
+    bocetos.assign(n, BocetoKLL());
+    for (size_t i = 0; i < n; i++) {
+        uint64_t vistos, alto;
+        if (!leerValor(lector, vistos) || !leerValor(lector, alto)) return false;
+        if (alto > MAX_NIVELES_KLL || !lector.caben(alto, sizeof(uint64_t))) return false;
+        for (size_t h = 0; h < alto; h++) {
+            bocetos[i].agregarNivel();
+            if (!leerArreglo(lector, bocetos[i].niveles[h])) return false;
+        }
+        bocetos[i].n = vistos;
+        bocetos[i].tamano = bocetos[i].guardados();
+    }
+    return true;
+}
+
+inline bool guardarFragmento(const Fragmento& f, const string& destino) {
+    ofstream archivo(destino, ios::binary);
+    if (!archivo.is_open()) return false;
+    archivo.write(MAGIA_FRAGMENTO, sizeof(MAGIA_FRAGMENTO));
+    escribirValor(archivo, f.tamanoOrigen);
+    escribirValor(archivo, f.modificadoOrigen);
+    escribirValor(archivo, f.formato);
+    escribirValor(archivo, f.inferirAnio);
+    escribirValor(archivo, f.anioInicial);
+    escribirValor(archivo, f.mesInicial);
+    escribirValor(archivo, f.primerMes);
+    escribirValor(archivo, f.fechasInexistentes);
+    escribirValor(archivo, f.anioFinal);
+    escribirValor(archivo, f.mesFinal);
+    escribirValor(archivo, f.lineasLeidas);
+    escribirValor(archivo, f.lineasInvalidas);
+    escribirNombres(archivo, f.restaurantes);
+    escribirNombres(archivo, f.platillos);
+    escribirArreglo(archivo, f.fechas);
+    escribirArreglo(archivo, f.idRestaurante);
+    escribirArreglo(archivo, f.idPlatillo);
+    escribirArreglo(archivo, f.precios);
+    escribirArreglo(archivo, f.inicioLinea);
+    escribirCadena(archivo, f.texto);
+    escribirArreglo(archivo, f.frecuenciaPlatillo);
+    escribirValor(archivo, (uint64_t)f.aristas.size());
+    for (size_t p = 0; p < f.aristas.size(); p++) escribirArreglo(archivo, f.aristas[p]);
+    escribirBocetos(archivo, f.preciosRestaurante);
+    escribirBocetos(archivo, f.preciosPlatillo);
+    return (bool)archivo;
+}
+
+// ¿Todo lo que la fusión va a indexar está dentro de rango? Las columnas miden lo mismo,
+// los IDs existen en los diccionarios, cada línea empieza dentro del texto y la corrida está ordenada
+inline bool fragmentoConsistente(const Fragmento& f) {
+    size_t n = f.fechas.size();
+    size_t numRestaurantes = f.restaurantes.size(), numPlatillos = f.platillos.size();
+    if (f.idRestaurante.size() != n || f.idPlatillo.size() != n || f.precios.size() != n || f.inicioLinea.size() != n) return false;
+    if (!f.texto.empty() && f.texto.back() != '\0') return false;
+    for (size_t i = 0; i < n; i++) {
+        if (f.idRestaurante[i] < 0 || (size_t)f.idRestaurante[i] >= numRestaurantes) return false;
+        if (f.idPlatillo[i] < 0 || (size_t)f.idPlatillo[i] >= numPlatillos) return false;
+        if (f.inicioLinea[i] >= f.texto.size()) return false;
+        if (i > 0 && f.fechas[i] < f.fechas[i - 1]) return false;
+    }
+    if (f.frecuenciaPlatillo.size() > numPlatillos || f.aristas.size() > numPlatillos) return false;
+    for (size_t p = 0; p < f.aristas.size(); p++) {
+        for (size_t a = 0; a < f.aristas[p].size(); a++) {
+            if (f.aristas[p][a].first < 0 || (size_t)f.aristas[p][a].first >= numRestaurantes) return false;
+        }
+    }
+    return f.preciosRestaurante.size() <= numRestaurantes && f.preciosPlatillo.size() <= numPlatillos;
+}
+
+// Lee un .frag; regresa false si no existe, está dañado o es de otra versión (y entonces
+// quien llama vuelve a parsear la bitácora)
+inline bool leerFragmento(const string& origen, Fragmento& f) {
+    LectorFragmento lector;
+    if (!lector.abrir(origen)) return false;
+    char magia[sizeof(MAGIA_FRAGMENTO)];
+    if (!lector.leer(magia, sizeof(magia)) || memcmp(magia, MAGIA_FRAGMENTO, sizeof(magia)) != 0) return false;
+    uint64_t numPlatillos;
+    bool completo = leerValor(lector, f.tamanoOrigen) && leerValor(lector, f.modificadoOrigen)
+        && leerValor(lector, f.formato)
+        && leerValor(lector, f.inferirAnio) && leerValor(lector, f.anioInicial)
+        && leerValor(lector, f.mesInicial) && leerValor(lector, f.primerMes)
+        && leerValor(lector, f.fechasInexistentes) && leerValor(lector, f.anioFinal)
+        && leerValor(lector, f.mesFinal)
+        && leerValor(lector, f.lineasLeidas) && leerValor(lector, f.lineasInvalidas)
+        && leerNombres(lector, f.restaurantes) && leerNombres(lector, f.platillos)
+        && leerArreglo(lector, f.fechas) && leerArreglo(lector, f.idRestaurante)
+        && leerArreglo(lector, f.idPlatillo) && leerArreglo(lector, f.precios)
+        && leerArreglo(lector, f.inicioLinea) && leerCadena(lector, f.texto)
+        && leerArreglo(lector, f.frecuenciaPlatillo) && leerValor(lector, numPlatillos);
+    if (!completo || !lector.caben(numPlatillos, sizeof(uint64_t))) return false;
+    f.aristas.resize(numPlatillos);
+    for (size_t p = 0; p < numPlatillos; p++) {
+        if (!leerArreglo(lector, f.aristas[p])) return false;
+    }
+    return leerBocetos(lector, f.preciosRestaurante) && leerBocetos(lector, f.preciosPlatillo)
+        && lector.restantes == 0 && fragmentoConsistente(f);
+}
+
+// --- CONSTRUCCIÓN DE UN FRAGMENTO ---
+
+// Parsea un archivo con un motor propio, empezando con el año y último mes de 'inicio' y con
+// el tokenizador y formato de 'principal', y se queda con su resultado parcial
+inline bool construirFragmento(const string& ruta, const Calendario& inicio, const Motor& principal, Fragmento& f) {
+    Motor parcial;
+    parcial.mascaras = principal.mascaras;
+    parcial.nombreTokenizador = principal.nombreTokenizador;
+    parcial.formato = principal.formato;
+    parcial.calendario.configurar(inicio.anioBase, inicio.inferirAnio);
+    parcial.calendario.anioActual = inicio.anioActual;
+    parcial.calendario.ultimoMes = inicio.ultimoMes;
+    if (!parcial.cargarArchivo(ruta.c_str())) return false;
+    parcial.ingerir();
+    parcial.ordenarPorFecha();
+
+    const Calendario& final = parcial.calendario;
+    f.formato = parcial.formato;
+    f.inferirAnio = inicio.inferirAnio;
+    f.anioInicial = inicio.anioActual;
+    f.mesInicial = inicio.ultimoMes;
+    f.primerMes = final.primerMes;
+    f.fechasInexistentes = final.fechasInexistentes;
+    f.anioFinal = final.anioActual;
+    f.mesFinal = final.ultimoMes;
+
+    f.lineasLeidas = parcial.lineasLeidas;
+    f.lineasInvalidas = parcial.lineasInvalidas;
+    f.restaurantes = parcial.restaurantes.nombres;
+    f.platillos = parcial.platillos.nombres;
+
+    const AlmacenOrdenes& ordenes = parcial.ordenes;
+    for (size_t i = 0; i < parcial.ordenPorFecha.size(); i++) {
+        int id = parcial.ordenPorFecha[i];
+        f.fechas.push_back(ordenes.fechas[id]);
+        f.idRestaurante.push_back(ordenes.idRestaurante[id]);
+        f.idPlatillo.push_back(ordenes.idPlatillo[id]);
+        f.precios.push_back(ordenes.precios[id]);
+        f.inicioLinea.push_back(f.texto.size());
+        f.texto += parcial.linea(id);
+        f.texto += '\0';
+    }
+
+    f.frecuenciaPlatillo = parcial.frecuenciaPlatillo;
+    // Las listas tienen al frente la arista más nueva; se guardan al revés para que
+    // la fusión las vuelva a insertar en el mismo orden
+    f.aristas.resize(parcial.platillos.tamano());
+    for (int p = 0; p < parcial.platillos.tamano(); p++) {
+        for (NodoAdyacencia* v = parcial.grafo.vecinos(p); v != nullptr; v = v->siguiente) {
+            f.aristas[p].push_back(make_pair(v->idDestino, v->peso));
+        }
+        reverse(f.aristas[p].begin(), f.aristas[p].end());
+    }
+
+    for (size_t r = 0; r < parcial.bocetosRestaurante.size(); r++) {
+        f.preciosRestaurante.push_back(parcial.bocetosRestaurante[r].precios);
+    }
+    f.preciosPlatillo = parcial.preciosPlatillo;
+    return true;
+}
+
+// --- AÑO ENTRE FRAGMENTOS ---
+
+// ¿Parsear el archivo como lo hizo 'f' da lo mismo que parsearlo empezando en 'inicio'?
+// Además del mismo estado inicial, un fragmento que empezó sin mes anterior sirve si su
+// primera línea cae en el mismo año con cualquiera de los dos estados: a partir de ahí
+// el calendario va igual. Si alguna fecha no existía (29 de febrero) el año pudo cambiar
+// qué líneas se aceptan, y solo vale el mismo estado
+inline bool fragmentoEquivalente(const Fragmento& f, const Calendario& inicio) {
+    if (f.inferirAnio != inicio.inferirAnio) return false;
+    if (f.anioInicial == inicio.anioActual && f.mesInicial == inicio.ultimoMes) return true;
+    if (!inicio.inferirAnio || f.mesInicial != 0 || f.fechasInexistentes > 0) return false;
+    if (f.primerMes == 0) return true;   // ninguna línea llegó al calendario
+    if (inicio.ultimoMes == 0) return f.anioInicial == inicio.anioActual;
+    if (f.primerMes + 6 < inicio.ultimoMes) return f.anioInicial == inicio.anioActual + 1;
+    if (f.primerMes > inicio.ultimoMes + 6) return false; // sería línea rezagada del año anterior
+    return f.anioInicial == inicio.anioActual;
+}
+
+// Deja en 'estado' el calendario después de un fragmento equivalente a él
+inline void avanzarCalendario(Calendario& estado, const Fragmento& f) {
+    if (f.mesInicial == 0 && f.primerMes == 0) return; // no tocó el calendario
+    estado.anioActual = f.anioFinal;
+    estado.ultimoMes = f.mesFinal;
+}
+
+// --- OBTENER LOS FRAGMENTOS ---
+
+// Usa el .frag si sigue vigente (misma bitácora y equivalente a empezar en 'inicio'); si no,
+// parsea la bitácora y guarda el .frag nuevo. Con cualquierInicio acepta un .frag vigente que
+// empezó en otro estado del calendario: quien llama lo revisa después con fragmentoEquivalente
+inline bool obtenerFragmento(const string& ruta, const Calendario& inicio, bool cualquierInicio,
+                             const Motor& principal, Fragmento& f) {
+    long long tamano, modificado;
+    if (!datosArchivo(ruta, tamano, modificado)) return false;
+    string rutaFragmento = ruta + EXTENSION_FRAGMENTO;
+
+    if (leerFragmento(rutaFragmento, f) && f.tamanoOrigen == tamano && f.modificadoOrigen == modificado
+        && f.formato == principal.formato
+        && f.inferirAnio == inicio.inferirAnio && (cualquierInicio || fragmentoEquivalente(f, inicio))) {
+        f.ruta = ruta;
+        f.reutilizado = true;
+        return true;
+    }
+
+    f = Fragmento();
+    f.ruta = ruta;
+    f.tamanoOrigen = tamano;
+    f.modificadoOrigen = modificado;
+    if (!construirFragmento(ruta, inicio, principal, f)) return false;
+    guardarFragmento(f, rutaFragmento); // si no se puede guardar, solo se pierde la reutilización
+    return true;
+}
+
+// Obtiene todos los fragmentos repartiéndolos entre 'hilos' hilos, con el calendario, el
+// tokenizador y el formato de 'principal'. Con --inferir-anio después los recorre en orden
+// heredando el calendario y reparsea los que no coinciden
+inline bool obtenerFragmentos(const vector<string>& rutas, const Motor& principal,
+                              vector<Fragmento>& fragmentos, int hilos) {
+    Calendario inicio;
+    inicio.configurar(principal.calendario.anioBase, principal.calendario.inferirAnio);
+    fragmentos.assign(rutas.size(), Fragmento());
+    vector<char> correcto(rutas.size(), 0);
+    atomic<size_t> siguiente(0);
+    auto trabajar = [&]() {
+        for (size_t i = siguiente++; i < rutas.size(); i = siguiente++) {
+            correcto[i] = obtenerFragmento(rutas[i], inicio, inicio.inferirAnio, principal, fragmentos[i]);
+        }
+    };
+
+    hilos = min(resolverHilos(hilos), (int)rutas.size());
+    vector<thread> trabajadores;
+    for (int i = 1; i < hilos; i++) trabajadores.emplace_back(trabajar);
+    trabajar();
+    for (size_t i = 0; i < trabajadores.size(); i++) trabajadores[i].join();
+
+    for (size_t i = 0; i < rutas.size(); i++) {
+        if (!correcto[i]) return false;
+    }
+
+    if (inicio.inferirAnio) {
+        Calendario estado = inicio;
+        for (size_t i = 0; i < rutas.size(); i++) {
+            if (!fragmentoEquivalente(fragmentos[i], estado)
+                && !obtenerFragmento(rutas[i], estado, false, principal, fragmentos[i])) return false;
+            avanzarCalendario(estado, fragmentos[i]);
+        }
+    }
+    return true;
+}
+
+// --- FUSIÓN ---
+
+// Combina los fragmentos, en orden, en un motor vacío. Queda listo para construirIndices()
+inline void fusionarFragmentos(Motor& motor, const vector<Fragmento>& fragmentos) {
+    vector<vector<int>> corridas(fragmentos.size());
+    for (size_t k = 0; k < fragmentos.size(); k++) {
+        const Fragmento& f = fragmentos[k];
+
+        // IDs locales -> globales; los nombres nuevos se agregan en el orden en que aparecieron
+        vector<int> mapaRestaurante(f.restaurantes.size()), mapaPlatillo(f.platillos.size());
+        for (size_t r = 0; r < f.restaurantes.size(); r++) {
+            mapaRestaurante[r] = motor.restaurantes.obtenerOcrear(f.restaurantes[r].c_str(), f.restaurantes[r].size());
+        }
+        for (size_t p = 0; p < f.platillos.size(); p++) {
+            mapaPlatillo[p] = motor.platillos.obtenerOcrear(f.platillos[p].c_str(), f.platillos[p].size());
+        }
+        if (motor.platillos.tamano() > (int)motor.frecuenciaPlatillo.size()) {
+            motor.frecuenciaPlatillo.resize(motor.platillos.tamano(), 0);
+            motor.preciosPlatillo.resize(motor.platillos.tamano());
+        }
+        if (motor.restaurantes.tamano() > (int)motor.bocetosRestaurante.size()) {
+            motor.bocetosRestaurante.resize(motor.restaurantes.tamano());
+        }
+
+        // Columnas y texto: la corrida del fragmento se agrega tal cual
+        size_t baseTexto = motor.texto.size();
+        motor.texto += f.texto;
+        int primera = motor.ordenes.total();
+        for (size_t i = 0; i < f.fechas.size(); i++) {
+            int idRestaurante = mapaRestaurante[f.idRestaurante[i]];
+            int idPlatillo = mapaPlatillo[f.idPlatillo[i]];
+            motor.ordenes.agregar(f.fechas[i], idRestaurante, idPlatillo, f.precios[i], baseTexto + f.inicioLinea[i]);
+            corridas[k].push_back(primera + i);
+            // Los HLL dependen de los IDs globales, así que se llenan aquí
+            FechaCivil civil = descomponerFecha(f.fechas[i]);
+            motor.bocetosRestaurante[idRestaurante].deMes(civil.anio, civil.mes).agregar(idPlatillo);
+        }
+
+        // Frecuencias, aristas y cuantiles de precio
+        for (size_t p = 0; p < f.frecuenciaPlatillo.size(); p++) {
+            motor.frecuenciaPlatillo[mapaPlatillo[p]] += f.frecuenciaPlatillo[p];
+        }
+        for (size_t p = 0; p < f.aristas.size(); p++) {
+            for (size_t a = 0; a < f.aristas[p].size(); a++) {
+                motor.grafo.agregarArista(mapaPlatillo[p], mapaRestaurante[f.aristas[p][a].first], f.aristas[p][a].second);
+            }
+        }
+        for (size_t r = 0; r < f.preciosRestaurante.size(); r++) {
+            motor.bocetosRestaurante[mapaRestaurante[r]].precios.fusionar(f.preciosRestaurante[r]);
+        }
+        for (size_t p = 0; p < f.preciosPlatillo.size(); p++) {
+            motor.preciosPlatillo[mapaPlatillo[p]].fusionar(f.preciosPlatillo[p]);
+        }
+
+        motor.lineasLeidas += f.lineasLeidas;
+        motor.lineasInvalidas += f.lineasInvalidas;
+    }
+    motor.texto += '\0'; // el '\0' extra del final, igual que cargarArchivo
+
+    // Las corridas ya vienen ordenadas; en empates gana el fragmento anterior
+    vector<const vector<int>*> punteros;
+    for (size_t k = 0; k < corridas.size(); k++) punteros.push_back(&corridas[k]);
+    motor.ordenPorFecha = mezclarCorridas(punteros, motor.ordenes.fechas);
+}
+
+#endif
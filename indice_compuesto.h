@@ -0,0 +1,76 @@
+/*
+ÍNDICE COMPUESTO (ID, FECHA)
+Para preguntar por las órdenes de UN restaurante (o platillo) dentro de un rango de fechas
+sin filtrar el resultado del rango global:
+- Cada orden del segmento principal se representa con una llave de 64 bits:
+  ID en los bits altos y fecha en los BITS_FECHA_COMPUESTA bits bajos
+- Las llaves se guardan en un arreglo ordenado junto con la posición de la orden en el
+  segmento principal; así el rango (ID, inicio)..(ID, fin) son dos búsquedas binarias
+- Como el segmento principal ya está ordenado por fecha, basta un counting sort por ID
+  (estable) para obtener el arreglo ordenado en tiempo lineal
+- La fecha va dentro de la llave: contar por hora no necesita tocar las órdenes
+
+Autores: Equipo SProblema 5
+ - Franco Varela Villegas - A01199186
+ - Nerik Nieto Gutiérrez - A01739652
+ - Eduardo Mora Howard - A00829920
+*/
+
+#ifndef INDICE_COMPUESTO_H
+#define INDICE_COMPUESTO_H
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+
+#define BITS_FECHA_COMPUESTA 40
+#define MASCARA_FECHA_COMPUESTA ((1ULL << BITS_FECHA_COMPUESTA) - 1)
+
+inline uint64_t llaveCompuesta(int id, unsigned long int fecha) {
+    return (uint64_t)id << BITS_FECHA_COMPUESTA | (fecha & MASCARA_FECHA_COMPUESTA);
+}
+
+inline unsigned long int fechaDeLlave(uint64_t llave) {
+    return llave & MASCARA_FECHA_COMPUESTA;
+}
+
+struct IndiceCompuesto {
+    vector<uint64_t> llaves;     // ordenadas: (ID, fecha)
+    vector<int> posiciones;      // posición de cada orden en el segmento principal
+
+    // idEn(p) y fechaEn(p) dan el ID y la fecha de la orden en la posición p del principal,
+    // que está ordenado por fecha
+    template <typename Id, typename Fecha>
+    void construir(size_t n, int numIds, Id idEn, Fecha fechaEn) {
+        vector<size_t> inicio(numIds + 1, 0);
+        for (size_t p = 0; p < n; p++) inicio[idEn(p) + 1]++;
+        for (int i = 0; i < numIds; i++) inicio[i + 1] += inicio[i];
+
+        llaves.assign(n, 0);
+        posiciones.assign(n, 0);
+        for (size_t p = 0; p < n; p++) {
+            int id = idEn(p);
+            size_t destino = inicio[id]++;
+            llaves[destino] = llaveCompuesta(id, fechaEn(p));
+            posiciones[destino] = p;
+        }
+    }
+
+    // [desde, hasta) dentro de 'llaves' con ese ID y fecha en [fechaInicio, fechaFin]
+    void rango(int id, unsigned long int fechaInicio, unsigned long int fechaFin, size_t& desde, size_t& hasta) const {
+        desde = hasta = 0;
+        if (fechaInicio > MASCARA_FECHA_COMPUESTA || fechaInicio > fechaFin) return;
+        if (fechaFin > MASCARA_FECHA_COMPUESTA) fechaFin = MASCARA_FECHA_COMPUESTA;
+        desde = lower_bound(llaves.begin(), llaves.end(), llaveCompuesta(id, fechaInicio)) - llaves.begin();
+        hasta = upper_bound(llaves.begin(), llaves.end(), llaveCompuesta(id, fechaFin)) - llaves.begin();
+        if (hasta < desde) hasta = desde;
+    }
+
+    size_t bytesUsados() const {
+        return llaves.size() * sizeof(uint64_t) + posiciones.size() * sizeof(int);
+    }
+};
+
+#endif
@@ -0,0 +1,286 @@
+/*
+MARCAS DE TIEMPO DE 64 BITS
+La bitácora no trae año ("Feb 7 17:8:30"). Empacar la fecha como MMDDHHMMSS ordenaba mal
+las bitácoras que cruzan de diciembre a enero, así que cada orden se guarda en segundos
+desde 1970-01-01 (UTC, sin zonas horarias):
+- El año sale de --anio (por defecto ANIO_BASE_DEFECTO). Con --inferir-anio, una bitácora
+  cronológica que regresa de un mes tardío a uno temprano (Dic -> ene) pasa al año siguiente
+- La llave es un entero sin signo que crece con el tiempo: sirve tal cual para ordenar,
+  para las búsquedas binarias y para los índices compuestos
+- Las fechas que escribe el usuario se aceptan como en la bitácora ("Feb 7 17:8:30",
+  "Dic 24"), con año opcional al inicio ("2025 ene 3"), como MMDDHHMMSS o como "@segundos"
+
+Autores: Equipo SProblema 5
+ - Franco Varela Villegas - A01199186
+ - Nerik Nieto Gutiérrez - A01739652
+ - Eduardo Mora Howard - A00829920
+*/
+
+#ifndef MARCA_TIEMPO_H
+#define MARCA_TIEMPO_H
+
+#include <string>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cctype>
+#include <cstdint>
+
+using namespace std;
+
+#define ANIO_BASE_DEFECTO 2024
+#define SEGUNDOS_DIA 86400UL
+
+// Nombres de los meses tal como aparecen en la bitácora
+constexpr const char* NOMBRES_MES[12] = {"ene", "Feb", "Mar", "Abr", "May", "Jun", "Jul", "Ago", "Sep", "Oct", "Nov", "Dic"};
+
+// --- DECODIFICADOR DE MESES ---
+// Hash perfecto armado al compilar: las tres letras (en minúsculas) forman una llave de 24 bits
+// y un multiplicador la manda a una de RANURAS_MES ranuras sin choques. Decodificar un mes es
+// una multiplicación, un corrimiento y una comparación, sin recorrer los doce nombres
+
+#define BITS_RANURA_MES 4
+#define RANURAS_MES (1 << BITS_RANURA_MES)
+
+// Tres letras en minúsculas; |0x20 solo junta mayúsculas y minúsculas de una misma letra
+constexpr uint32_t llaveMes(const char* mes) {
+    return (uint32_t)(mes[0] | 0x20) << 16 | (uint32_t)(mes[1] | 0x20) << 8 | (uint32_t)(mes[2] | 0x20);
+}
+
+constexpr uint32_t ranuraMes(uint32_t llave, uint32_t multiplicador) {
+    return (uint32_t)(llave * multiplicador) >> (32 - BITS_RANURA_MES);
+}
+
+// Prueba múltiplos de la razón áurea hasta que los doce meses caigan en ranuras distintas
+constexpr uint32_t buscarMultiplicadorMes() {
+    for (uint32_t i = 1; i < 4096; i++) {
+        uint32_t multiplicador = i * 0x9E3779B1u;
+        bool ocupada[RANURAS_MES] = {};
+        bool perfecto = true;
+        for (int m = 0; m < 12 && perfecto; m++) {
+            uint32_t ranura = ranuraMes(llaveMes(NOMBRES_MES[m]), multiplicador);
+            perfecto = !ocupada[ranura];
+            ocupada[ranura] = true;
+        }
+        if (perfecto) return multiplicador;
+    }
+    return 0;
+}
+
+struct TablaMeses {
+    uint32_t multiplicador;
+    uint32_t llaves[RANURAS_MES];  // llave del mes en cada ranura (0 = libre)
+    uint8_t meses[RANURAS_MES];    // 1-12
+};
+
+constexpr TablaMeses construirTablaMeses() {
+    TablaMeses tabla = {buscarMultiplicadorMes(), {}, {}};
+    for (int m = 0; m < 12; m++) {
+        uint32_t llave = llaveMes(NOMBRES_MES[m]);
+        tabla.llaves[ranuraMes(llave, tabla.multiplicador)] = llave;
+        tabla.meses[ranuraMes(llave, tabla.multiplicador)] = m + 1;
+    }
+    return tabla;
+}
+
+constexpr TablaMeses TABLA_MESES = construirTablaMeses();
+static_assert(TABLA_MESES.multiplicador != 0, "no hay hash perfecto para los meses con RANURAS_MES ranuras");
+
+// Convierte las tres letras del mes a su número (1-12), 0 si no se reconoce
+constexpr int numeroMes(const char* mes) {
+    if (mes[0] == '\0' || mes[1] == '\0') return 0; // no leer después del fin de la cadena
+    uint32_t llave = llaveMes(mes);
+    uint32_t ranura = ranuraMes(llave, TABLA_MESES.multiplicador);
+    return TABLA_MESES.llaves[ranura] == llave ? TABLA_MESES.meses[ranura] : 0;
+}
+
+static_assert(numeroMes("ene") == 1 && numeroMes("FEB") == 2 && numeroMes("Dic") == 12 && numeroMes("abc") == 0,
+              "decodificador de meses");
+
+// --- CALENDARIO CIVIL ---
+// Conversión día <-> (año, mes, día) sin tablas ni ciclos (algoritmo de H. Hinnant)
+
+inline bool esBisiesto(int anio) {
+    return (anio % 4 == 0 && anio % 100 != 0) || anio % 400 == 0;
+}
+
+inline int diasEnMes(int anio, int mes) {
+    static const int dias[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return mes == 2 && esBisiesto(anio) ? 29 : dias[mes - 1];
+}
+
+// Días desde 1970-01-01
+inline long diasDesdeEpoca(int anio, int mes, int dia) {
+    anio -= mes <= 2;
+    long era = (anio >= 0 ? anio : anio - 399) / 400;
+    long anioDeEra = anio - era * 400;
+    long diaDelAnio = (153 * (mes + (mes > 2 ? -3 : 9)) + 2) / 5 + dia - 1;
+    long diaDeEra = anioDeEra * 365 + anioDeEra / 4 - anioDeEra / 100 + diaDelAnio;
+    return era * 146097 + diaDeEra - 719468;
+}
+
+inline void fechaCivil(long dias, int& anio, int& mes, int& dia) {
+    dias += 719468;
+    long era = (dias >= 0 ? dias : dias - 146096) / 146097;
+    long diaDeEra = dias - era * 146097;
+    long anioDeEra = (diaDeEra - diaDeEra / 1460 + diaDeEra / 36524 - diaDeEra / 146096) / 365;
+    long diaDelAnio = diaDeEra - (365 * anioDeEra + anioDeEra / 4 - anioDeEra / 100);
+    long mesDesdeMarzo = (5 * diaDelAnio + 2) / 153;
+    dia = diaDelAnio - (153 * mesDesdeMarzo + 2) / 5 + 1;
+    mes = mesDesdeMarzo < 10 ? mesDesdeMarzo + 3 : mesDesdeMarzo - 9;
+    anio = anioDeEra + era * 400 + (mes <= 2);
+}
+
+inline unsigned long int segundosEpoca(int anio, int mes, int dia, int segundosDelDia) {
+    return (unsigned long int)diasDesdeEpoca(anio, mes, dia) * SEGUNDOS_DIA + segundosDelDia;
+}
+
+// Campos de una marca de tiempo
+struct FechaCivil {
+    int anio, mes, dia, horas, minutos, segundos;
+};
+
+inline FechaCivil descomponerFecha(unsigned long int fecha) {
+    FechaCivil f;
+    fechaCivil(fecha / SEGUNDOS_DIA, f.anio, f.mes, f.dia);
+    int resto = fecha % SEGUNDOS_DIA;
+    f.horas = resto / 3600;
+    f.minutos = resto / 60 % 60;
+    f.segundos = resto % 60;
+    return f;
+}
+
+// "2024-02-07 17:08:30"
+inline string formatearFecha(unsigned long int fecha) {
+    FechaCivil f = descomponerFecha(fecha);
+    char texto[32];
+    snprintf(texto, sizeof(texto), "%04d-%02d-%02d %02d:%02d:%02d", f.anio, f.mes, f.dia, f.horas, f.minutos, f.segundos);
+    return texto;
+}
+
+// --- AÑO DE CADA LÍNEA ---
+struct Calendario {
+    int anioBase = ANIO_BASE_DEFECTO;
+    bool inferirAnio = false;   // la bitácora es cronológica: Dic -> ene es año nuevo
+    int anioActual = ANIO_BASE_DEFECTO;
+    int ultimoMes = 0;          // 0 = todavía no hay mes anterior
+    int primerMes = 0;          // mes de la primera línea que fijó el estado
+    int fechasInexistentes = 0; // líneas con un día que no existe en su mes
+
+    void configurar(int anio, bool inferir) {
+        anioBase = anioActual = anio;
+        inferirAnio = inferir;
+        ultimoMes = primerMes = fechasInexistentes = 0;
+    }
+
+    // Convierte los campos de una línea a segundos y dice de qué año es. Regresa false si el
+    // día no existe en ese mes; una línea así no cambia el año
+    bool marcaDeLinea(int mes, int dia, int segundosDelDia, int& anio, unsigned long int& fecha) {
+        anio = anioActual;
+        if (inferirAnio && ultimoMes != 0) {
+            if (mes + 6 < ultimoMes) {
+                anio++;                  // regresó de un mes tardío a uno temprano
+            } else if (mes > ultimoMes + 6) {
+                anio--;                  // línea rezagada del año anterior; no mueve el estado
+            }
+        }
+        if (dia < 1 || dia > diasEnMes(anio, mes)) {
+            fechasInexistentes++;
+            return false;
+        }
+        if (anio >= anioActual) {
+            anioActual = anio;
+            ultimoMes = mes;
+            if (primerMes == 0) primerMes = mes;
+        }
+        fecha = segundosEpoca(anio, mes, dia, segundosDelDia);
+        return true;
+    }
+};
+
+// --- FECHAS ESCRITAS POR EL USUARIO ---
+
+inline bool leerEnteroTexto(const char*& p, long& valor) {
+    if (!isdigit((unsigned char)*p)) return false;
+    char* fin;
+    valor = strtol(p, &fin, 10);
+    p = fin;
+    return true;
+}
+
+inline void saltarEspacios(const char*& p) {
+    while (*p == ' ' || *p == '\t') p++;
+}
+
+// Acepta "[AAAA] Mes D [H[:M[:S]]]", "MMDDHHMMSS" o "@segundos". Las partes omitidas de la
+// hora valen 0 en el inicio de un rango y el máximo en el fin ("Dic 24" como fin = hasta 23:59:59).
+// Si se pasa 'anioEscrito' dice si el texto fijó el año (con año al frente o "@segundos")
+inline bool leerFechaUsuario(const char* texto, int anioBase, bool esFin, unsigned long int& fecha,
+                             bool* anioEscrito = nullptr) {
+    const char* p = texto;
+    saltarEspacios(p);
+    long valor;
+
+    if (anioEscrito) *anioEscrito = *p == '@';
+    if (*p == '@') {
+        p++;
+        if (!leerEnteroTexto(p, valor)) return false;
+        fecha = valor;
+        saltarEspacios(p);
+        return *p == '\0';
+    }
+
+    int anio = anioBase, mes, dia;
+    long partes[3] = {-1, -1, -1};
+    const char* inicio = p;
+    if (leerEnteroTexto(p, valor)) {
+        saltarEspacios(p);
+        if (*p == '\0' && p - inicio > 4) {
+            // Formato anterior MMDDHHMMSS
+            mes = valor / 100000000L;
+            dia = valor / 1000000L % 100;
+            partes[0] = valor / 10000L % 100;
+            partes[1] = valor / 100L % 100;
+            partes[2] = valor % 100;
+        } else {
+            // Año al frente y luego el mes con letras
+            anio = valor;
+            if (anioEscrito) *anioEscrito = true;
+            mes = numeroMes(p);
+            if (mes == 0) return false;
+            while (isalpha((unsigned char)*p)) p++;
+            saltarEspacios(p);
+            if (!leerEnteroTexto(p, valor)) return false;
+            dia = valor;
+        }
+    } else {
+        mes = numeroMes(p);
+        if (mes == 0) return false;
+        while (isalpha((unsigned char)*p)) p++;
+        saltarEspacios(p);
+        if (!leerEnteroTexto(p, valor)) return false;
+        dia = valor;
+    }
+
+    // Hora opcional: H, H:M o H:M:S
+    saltarEspacios(p);
+    bool conHora = partes[0] >= 0; // el formato MMDDHHMMSS ya la trae
+    for (int i = 0; i < 3 && !conHora && *p != '\0'; i++) {
+        if (i > 0 && *p++ != ':') return false;
+        if (!leerEnteroTexto(p, partes[i])) return false;
+        if (*p != ':') break;
+    }
+    saltarEspacios(p);
+    if (*p != '\0') return false;
+
+    const long maximos[3] = {23, 59, 59};
+    for (int i = 0; i < 3; i++) {
+        if (partes[i] < 0) partes[i] = esFin ? maximos[i] : 0;
+        if (partes[i] > maximos[i]) return false;
+    }
+    if (anio < 1970 || mes < 1 || mes > 12 || dia < 1 || dia > diasEnMes(anio, mes)) return false;
+    fecha = segundosEpoca(anio, mes, dia, partes[0] * 3600 + partes[1] * 60 + partes[2]);
+    return true;
+}
+
+#endif
@@ -0,0 +1,173 @@
+/*
+MATRIZ WAVELET SOBRE LA SECUENCIA DE PLATILLOS ORDENADA POR FECHA
+Índice sucinto para contestar preguntas sobre una ventana de tiempo sin recontar:
+- Frecuencia de un platillo dentro de un rango de posiciones: O(log σ)
+- Top-K platillos más pedidos dentro del rango: O(K log σ) recorriendo primero los nodos más grandes
+- Platillos distintos dentro del rango: O(d log σ), d = número de distintos
+σ es el número de platillos distintos. Cada nivel guarda un bit por orden con rank en O(1).
+
+Autores: Equipo SProblema 5
+ - Franco Varela Villegas - A01199186
+ - Nerik Nieto Gutiérrez - A01739652
+ - Eduardo Mora Howard - A00829920
+*/
+
+#ifndef MATRIZ_WAVELET_H
+#define MATRIZ_WAVELET_H
+
+#include <vector>
+#include <queue>
+#include <cstdint>
+
+using namespace std;
+
+// --- VECTOR DE BITS CON RANK ---
+// Cada 8 palabras de 64 bits se guarda cuántos unos hay antes (superbloque)
+struct VectorBits {
+    vector<uint64_t> palabras;
+    vector<uint64_t> unosAntes;
+    size_t n = 0;
+
+    void inicializar(size_t tamano) {
+        n = tamano;
+        palabras.assign((n + 63) / 64, 0);
+    }
+
+    void poner(size_t i) { palabras[i >> 6] |= 1ULL << (i & 63); }
+    bool obtener(size_t i) const { return (palabras[i >> 6] >> (i & 63)) & 1; }
+
+    // Se llama una vez que todos los bits están puestos
+    void construirRank() {
+        unosAntes.assign(palabras.size() / 8 + 1, 0);
+        uint64_t acumulado = 0;
+        for (size_t w = 0; w < palabras.size(); w++) {
+            if (w % 8 == 0) unosAntes[w / 8] = acumulado;
+            acumulado += __builtin_popcountll(palabras[w]);
+        }
+        if (palabras.size() % 8 == 0) unosAntes[palabras.size() / 8] = acumulado;
+    }
+
+    // Unos en [0, i)
+    size_t rank1(size_t i) const {
+        size_t w = i >> 6;
+        size_t cuenta = unosAntes[w / 8];
+        for (size_t j = w & ~(size_t)7; j < w; j++) cuenta += __builtin_popcountll(palabras[j]);
+        if (i & 63) cuenta += __builtin_popcountll(palabras[w] & ((1ULL << (i & 63)) - 1));
+        return cuenta;
+    }
+
+    size_t rank0(size_t i) const { return i - rank1(i); }
+};
+
+// Un platillo y cuántas veces aparece en el rango consultado
+struct ConteoPlatillo {
+    int idPlatillo;
+    size_t pedidos;
+};
+
+// --- MATRIZ WAVELET ---
+// Nivel 0 = bit más significativo del ID. En cada nivel los ceros se acomodan antes que los unos
+struct MatrizWavelet {
+    int niveles = 0;
+    size_t n = 0;
+    vector<VectorBits> bits;
+    vector<size_t> ceros; // total de ceros en cada nivel
+
+    void construir(const vector<int>& secuencia, int sigma) {
+        n = secuencia.size();
+        niveles = 1;
+        while ((1 << niveles) < sigma) niveles++;
+        bits.assign(niveles, VectorBits());
+        ceros.assign(niveles, 0);
+
+        vector<int> actual = secuencia, siguiente(n);
+        for (int nivel = 0; nivel < niveles; nivel++) {
+            int desplazamiento = niveles - 1 - nivel;
+            bits[nivel].inicializar(n);
+            size_t numCeros = 0;
+            for (size_t i = 0; i < n; i++) {
+                if ((actual[i] >> desplazamiento) & 1) bits[nivel].poner(i);
+                else numCeros++;
+            }
+            bits[nivel].construirRank();
+            ceros[nivel] = numCeros;
+
+            // Partición estable: primero los que tienen 0 en este bit, luego los que tienen 1
+            size_t posCero = 0, posUno = numCeros;
+            for (size_t i = 0; i < n; i++) {
+                if ((actual[i] >> desplazamiento) & 1) siguiente[posUno++] = actual[i];
+                else siguiente[posCero++] = actual[i];
+            }
+            actual.swap(siguiente);
+        }
+    }
+
+    // Veces que aparece el platillo en las posiciones [desde, hasta)
+    size_t frecuencia(size_t desde, size_t hasta, int simbolo) const {
+        if (desde >= hasta || simbolo < 0 || simbolo >= (1 << niveles)) return 0;
+        for (int nivel = 0; nivel < niveles; nivel++) {
+            const VectorBits& b = bits[nivel];
+            if ((simbolo >> (niveles - 1 - nivel)) & 1) {
+                desde = ceros[nivel] + b.rank1(desde);
+                hasta = ceros[nivel] + b.rank1(hasta);
+            } else {
+                desde = b.rank0(desde);
+                hasta = b.rank0(hasta);
+            }
+            if (desde == hasta) return 0;
+        }
+        return hasta - desde;
+    }
+
+    // Los K platillos más frecuentes en [desde, hasta). Se expanden primero los nodos con
+    // más elementos; como un hijo nunca es más grande que su padre, las primeras K hojas
+    // que salen de la cola son las de mayor frecuencia
+    vector<ConteoPlatillo> topK(size_t desde, size_t hasta, int k) const {
+        struct Nodo {
+            size_t desde, hasta;
+            int nivel;
+            int prefijo;
+            bool operator<(const Nodo& otro) const {
+                if (hasta - desde != otro.hasta - otro.desde) return hasta - desde < otro.hasta - otro.desde;
+                return prefijo > otro.prefijo; // en empate sale primero el ID menor
+            }
+        };
+
+        vector<ConteoPlatillo> resultado;
+        if (desde >= hasta || k <= 0) return resultado;
+
+        priority_queue<Nodo> cola;
+        cola.push({desde, hasta, 0, 0});
+        while (!cola.empty() && (int)resultado.size() < k) {
+            Nodo nodo = cola.top();
+            cola.pop();
+            if (nodo.nivel == niveles) {
+                resultado.push_back({nodo.prefijo, nodo.hasta - nodo.desde});
+                continue;
+            }
+            const VectorBits& b = bits[nodo.nivel];
+            size_t d0 = b.rank0(nodo.desde), h0 = b.rank0(nodo.hasta);
+            size_t d1 = ceros[nodo.nivel] + (nodo.desde - d0), h1 = ceros[nodo.nivel] + (nodo.hasta - h0);
+            if (h0 > d0) cola.push({d0, h0, nodo.nivel + 1, nodo.prefijo << 1});
+            if (h1 > d1) cola.push({d1, h1, nodo.nivel + 1, (nodo.prefijo << 1) | 1});
+        }
+        return resultado;
+    }
+
+    // Número de platillos distintos en [desde, hasta): solo se visitan ramas no vacías
+    int distintos(size_t desde, size_t hasta) const {
+        return contarDistintos(desde, hasta, 0);
+    }
+
+private:
+    int contarDistintos(size_t desde, size_t hasta, int nivel) const {
+        if (desde >= hasta) return 0;
+        if (nivel == niveles) return 1;
+        const VectorBits& b = bits[nivel];
+        size_t d0 = b.rank0(desde), h0 = b.rank0(hasta);
+        return contarDistintos(d0, h0, nivel + 1)
+             + contarDistintos(ceros[nivel] + (desde - d0), ceros[nivel] + (hasta - h0), nivel + 1);
+    }
+};
+
+#endif
@@ -0,0 +1,1152 @@
+/*
+MOTOR UNIFICADO DE ÓRDENES
+Un solo programa que lee la bitácora una vez y construye en la misma pasada las tres
+vistas que antes hacía cada entrega por separado:
+- Órdenes ordenadas por fecha con búsqueda por rango (primerEntrega)
+- Ranking de platillos por frecuencia (entrega_arboles)
+- Grafo bipartito Platillo -> Restaurante con BFS (entregafinal_listas)
+
+Uso:
+  ./motor_unificado [--archivo ruta] [--hilos N] [subcomando]
+  --hilos N                Hilos para ordenar por fecha (1 = serial, 0 = todos los núcleos)
+  --comprimido             Guarda las órdenes ordenadas en bloques comprimidos y libera el texto
+  --lote ruta              Agrega un archivo de órdenes nuevas como lote ordenado (se puede repetir)
+  --cache N                Líneas que guarda la caché de consultas (0 = sin caché)
+  --fragmentos ruta        Lee un archivo o un directorio de bitácoras por fragmentos (se puede repetir);
+                           cada uno guarda su resultado parcial en 'archivo.frag' y se reutiliza si no cambió
+  --perfil                 Mide cada fase con contadores de hardware (IPC, fallos de caché y de salto)
+  --ponderado              La similitud de menús pesa cada platillo por sus pedidos
+  --tokenizador T          auto | avx2 | sse2 | escalar (por defecto el mejor que soporte el procesador)
+  --anio N                 Año de las líneas de la bitácora, que no lo traen (por defecto 2024)
+  --inferir-anio           La bitácora es cronológica: al pasar de un mes tardío a uno temprano
+                           (Dic -> ene) las líneas siguientes son del año siguiente
+  --formato F              bitacora ("Feb 7 17:08:30 R:... O:...(140)", por defecto) o
+                           barras ("07/02 17:08:30 | restaurante | platillo | 140")
+Las fechas de los subcomandos y del menú se escriben como en la bitácora ("Feb 7 17:8:30",
+"Dic 24"), con año opcional al frente ("2025 ene 3"), o como MMDDHHMMSS en el año de --anio.
+Sin año, la fecha es del año de --anio; si el fin de un rango queda antes del inicio pasa al
+año siguiente ("Dic 28" a "ene 3"). Con --inferir-anio, un rango dentro del segundo año lleva año.
+Subcomandos:
+  menu                     Menú interactivo con todas las vistas (por defecto). Aparece de
+                           inmediato y la bitácora se carga en segundo plano
+  ordenes [inicio fin]     Primeros 10 registros, salida.txt y búsqueda por rango opcional
+  frecuencias              Platillos de más pedidos a menos
+  grafo                    Estadísticas, restaurantes con más solicitudes y matriz de adyacencia
+  top inicio fin [K]       Top K platillos y platillos distintos dentro del rango de fechas
+  conjuntos platillos|restaurantes y|o|menos nombre...
+                           Restaurantes que sirven todos/alguno de los platillos (o platillos de
+                           los restaurantes); "menos" quita al primero los demás; "*" es el conjunto de todos
+  restaurante nombre inicio fin  Órdenes de un restaurante dentro del rango (índice compuesto)
+  demanda-hora platillo [inicio fin]  Pedidos del platillo por hora del día
+  similares restaurante [K]  K restaurantes con el menú más parecido (MinHash + LSH)
+  similitud-bench [K]      Recall y tiempo de LSH contra Jaccard exacta para todos los restaurantes
+
+Autores: Equipo SProblema 5
+ - Franco Varela Villegas - A01199186
+ - Nerik Nieto Gutiérrez - A01739652
+ - Eduardo Mora Howard - A00829920
+*/
+
+#include "nucleo.h"
+#include "cargador_fondo.h"
+#include "fragmentos.h"
+#include <cmath>
+#include <climits>
+#include <chrono>
+
+// --- VISTA: ÓRDENES POR FECHA ---
+
+// Lee una fecha escrita por el usuario; avisa si no se entiende
+bool leerFecha(const Motor& motor, const char* texto, bool esFin, unsigned long int& fecha) {
+    if (leerFechaUsuario(texto, motor.calendario.anioBase, esFin, fecha)) return true;
+    cout << "Fecha no válida: '" << texto << "' (ej. Feb 7 17:8:30, 2025 ene 3 o MMDDHHMMSS)" << endl;
+    return false;
+}
+
+// Convierte las dos fechas de un rango. Si el fin no trae año y queda antes del inicio, es
+// del año siguiente: "Dic 28" a "ene 3" cruza el cambio de año como lo hace la bitácora
+bool leerRango(const Motor& motor, const char* textoInicio, const char* textoFin,
+               unsigned long int& fechaInicio, unsigned long int& fechaFin) {
+    if (!leerFecha(motor, textoInicio, false, fechaInicio)) return false;
+    bool anioEscrito;
+    if (!leerFechaUsuario(textoFin, motor.calendario.anioBase, true, fechaFin, &anioEscrito)) {
+        return leerFecha(motor, textoFin, true, fechaFin); // solo para mostrar el error
+    }
+    // Se prueba desde el año del inicio; "feb 29" puede necesitar hasta cuatro años
+    int anioInicio = descomponerFecha(fechaInicio).anio;
+    for (int anio = anioInicio; !anioEscrito && fechaFin < fechaInicio && anio <= anioInicio + 4; anio++) {
+        unsigned long int siguiente;
+        if (leerFechaUsuario(textoFin, anio, true, siguiente)) fechaFin = siguiente;
+    }
+    return true;
+}
+
+// Pide las dos fechas de un rango. Sin hora, el fin cubre el día completo
+bool pedirRango(const Motor& motor, unsigned long int& fechaInicio, unsigned long int& fechaFin) {
+    string inicio, fin;
+    cout << "Ingrese la fecha de inicio (ej. Feb 7 17:8:30): ";
+    getline(cin, inicio);
+    if (!leerFecha(motor, inicio.c_str(), false, fechaInicio)) return false;
+    cout << "Ingrese la fecha de fin (ej. Feb 13 o Feb 13 20:00): ";
+    getline(cin, fin);
+    return leerRango(motor, inicio.c_str(), fin.c_str(), fechaInicio, fechaFin);
+}
+
+// Muestra los primeros 10 registros ordenados
+void mostrarPrimeros10(const Motor& motor) {
+    cout << "\n=== PRIMEROS 10 REGISTROS ORDENADOS POR FECHA ===" << endl;
+    motor.recorrerRango(0, ULONG_MAX, 10, [](size_t i, const char* linea) {
+        cout << i + 1 << ". " << linea << endl;
+    });
+}
+
+// Guarda todos los registros ordenados en salida.txt
+void guardarOrdenamientoCompleto(const Motor& motor) {
+    ofstream archivo_salida("salida.txt");
+    if (archivo_salida.is_open()) {
+        motor.recorrerRango(0, ULONG_MAX, ULONG_MAX, [&archivo_salida](size_t, const char* linea) {
+            archivo_salida << linea << '\n';
+        });
+        archivo_salida.close();
+        cout << "\nArchivo 'salida.txt' creado exitosamente con " << motor.totalOrdenadas() << " registros ordenados." << endl;
+    } else {
+        cout << "Error al crear el archivo salida.txt" << endl;
+    }
+}
+
+// Muestra los registros dentro del rango de fechas. El resultado queda en la caché
+// y se regresa para que guardarlo en archivo no vuelva a buscar
+shared_ptr<const ResultadoConsulta> buscarPorRango(const Motor& motor, unsigned long int fechaInicio, unsigned long int fechaFin) {
+    cout << "\n=== RESULTADOS DE BÚSQUEDA ===" << endl;
+    cout << "Buscando registros entre fechas: " << formatearFecha(fechaInicio) << " y " << formatearFecha(fechaFin) << endl;
+
+    shared_ptr<const ResultadoConsulta> resultado = motor.consultarRango(fechaInicio, fechaFin);
+    const vector<string>& lineas = resultado->lineas;
+    for (size_t i = 0; i < lineas.size(); i++) {
+        cout << i + 1 << ". " << lineas[i] << '\n';
+    }
+
+    if (lineas.empty()) {
+        cout << "No se encontraron registros en el rango especificado." << endl;
+    } else {
+        cout << "\nTotal de registros encontrados: " << lineas.size() << endl;
+    }
+    return resultado;
+}
+
+// Guarda los resultados de la búsqueda en busqueda.txt
+void guardarBusqueda(const ResultadoConsulta& resultado, unsigned long int fechaInicio, unsigned long int fechaFin) {
+    ofstream archivo_busqueda("busqueda.txt");
+    if (archivo_busqueda.is_open()) {
+        archivo_busqueda << "=== RESULTADOS DE BÚSQUEDA ===" << endl;
+        archivo_busqueda << "Rango de fechas: " << formatearFecha(fechaInicio) << " a " << formatearFecha(fechaFin) << endl << endl;
+
+        for (size_t i = 0; i < resultado.lineas.size(); i++) {
+            archivo_busqueda << i + 1 << ". " << resultado.lineas[i] << '\n';
+        }
+
+        archivo_busqueda << "\nTotal de registros encontrados: " << resultado.lineas.size() << endl;
+        archivo_busqueda.close();
+        cout << "Resultados de búsqueda guardados en 'busqueda.txt'" << endl;
+    } else {
+        cout << "Error al crear el archivo de búsqueda" << endl;
+    }
+}
+
+// Pide el rango al usuario, lo busca y ofrece guardarlo
+void busquedaInteractiva(const Motor& motor) {
+    cout << "\n=== BÚSQUEDA POR RANGO DE FECHAS ===" << endl;
+    unsigned long int fechaInicio, fechaFin;
+    if (!pedirRango(motor, fechaInicio, fechaFin)) return;
+
+    shared_ptr<const ResultadoConsulta> resultado = buscarPorRango(motor, fechaInicio, fechaFin);
+
+    char opcion;
+    cout << "\n¿Desea guardar los resultados de búsqueda en un archivo? (s/n): ";
+    cin >> opcion;
+    cin.ignore(10000, '\n');
+
+    if (opcion == 's' || opcion == 'S') {
+        guardarBusqueda(*resultado, fechaInicio, fechaFin);
+    }
+}
+
+// --- VISTA: FRECUENCIA DE PLATILLOS ---
+
+// Muestra los platillos de mayor a menor frecuencia, agrupando los que empatan
+void imprimirFrecuencias(const Motor& motor) {
+    cout << "\n=== ÁRBOL DE FRECUENCIAS (de más pedidas a menos) ===\n";
+
+    vector<int> ranking(motor.platillos.tamano());
+    for (size_t i = 0; i < ranking.size(); i++) ranking[i] = i;
+    const vector<int>& frecuencia = motor.frecuenciaPlatillo;
+    stable_sort(ranking.begin(), ranking.end(), [&frecuencia](int a, int b) {
+        return frecuencia[a] > frecuencia[b];
+    });
+
+    size_t i = 0;
+    while (i < ranking.size()) {
+        int actual = frecuencia[ranking[i]];
+        cout << actual << " veces: ";
+        bool primero = true;
+        while (i < ranking.size() && frecuencia[ranking[i]] == actual) {
+            if (!primero) cout << ", ";
+            cout << motor.platillos.nombre(ranking[i]);
+            primero = false;
+            i++;
+        }
+        cout << endl;
+    }
+}
+
+// Top K platillos dentro de un rango de fechas usando la matriz wavelet (sin recontar)
+void topPlatillosEnRango(const Motor& motor, unsigned long int fechaInicio, unsigned long int fechaFin, int k) {
+    cout << "\n=== TOP " << k << " PLATILLOS ENTRE " << formatearFecha(fechaInicio) << " Y " << formatearFecha(fechaFin) << " ===" << endl;
+
+    size_t enRango = motor.contarEnRango(fechaInicio, fechaFin);
+    if (enRango == 0) {
+        cout << "No se encontraron registros en el rango especificado." << endl;
+        return;
+    }
+
+    vector<ConteoPlatillo> top = motor.topPlatillosEnRango(fechaInicio, fechaFin, k);
+    for (size_t i = 0; i < top.size(); i++) {
+        cout << i + 1 << ". " << motor.platillos.nombre(top[i].idPlatillo)
+             << " - " << top[i].pedidos << " pedidos" << endl;
+    }
+    cout << "\nÓrdenes en el rango: " << enRango << endl;
+    cout << "Platillos distintos en el rango: " << motor.distintosEnRango(fechaInicio, fechaFin) << endl;
+}
+
+// Pide rango, K y opcionalmente un platillo para ver su frecuencia en la ventana
+void analisisPorRangoInteractivo(const Motor& motor) {
+    unsigned long int fechaInicio, fechaFin;
+    int k;
+    cout << endl;
+    if (!pedirRango(motor, fechaInicio, fechaFin)) return;
+    cout << "¿Cuántos platillos desea ver? (K): ";
+    cin >> k;
+    cin.ignore(10000, '\n');
+
+    topPlatillosEnRango(motor, fechaInicio, fechaFin, k);
+
+    char busqueda[MAX_NOMBRE];
+    cout << "\nPlatillo para ver su frecuencia en el rango (Enter para omitir): ";
+    cin.getline(busqueda, MAX_NOMBRE);
+    if (busqueda[0] == '\0') return;
+
+    int idPlatillo = motor.platillos.buscar(busqueda);
+    if (idPlatillo == -1) {
+        cout << "Platillo no encontrado en la base de datos." << endl;
+        return;
+    }
+    cout << busqueda << ": " << motor.frecuenciaEnRango(fechaInicio, fechaFin, idPlatillo)
+         << " pedidos en el rango" << endl;
+}
+
+// --- VISTA: LÍNEA DE TIEMPO POR RESTAURANTE O PLATILLO ---
+
+// Órdenes de un restaurante dentro del rango de fechas
+void ordenesDeRestaurante(const Motor& motor, const char* nombre, unsigned long int fechaInicio, unsigned long int fechaFin) {
+    int id = motor.restaurantes.buscar(nombre);
+    if (id < 0) {
+        cout << "Restaurante no encontrado: " << nombre << endl;
+        return;
+    }
+    cout << "\n=== ÓRDENES DE " << nombre << " ENTRE " << formatearFecha(fechaInicio) << " Y " << formatearFecha(fechaFin) << " ===" << endl;
+    size_t total = motor.recorrerPorId(true, id, fechaInicio, fechaFin, ULONG_MAX, [](size_t i, const char* linea) {
+        cout << i + 1 << ". " << linea << '\n';
+    });
+    if (total == 0) cout << "No se encontraron registros en el rango especificado." << endl;
+    else cout << "\nTotal de registros encontrados: " << total << endl;
+}
+
+// Histograma de pedidos de un platillo por hora del día
+void demandaPorHora(const Motor& motor, const char* nombre, unsigned long int fechaInicio, unsigned long int fechaFin) {
+    int id = motor.platillos.buscar(nombre);
+    if (id < 0) {
+        cout << "Platillo no encontrado: " << nombre << endl;
+        return;
+    }
+    vector<size_t> horas = motor.demandaPorHora(id, fechaInicio, fechaFin);
+    size_t maximo = *max_element(horas.begin(), horas.end());
+    cout << "\n=== DEMANDA DE " << nombre << " POR HORA ===" << endl;
+    for (int h = 0; h < 24; h++) {
+        int barra = maximo > 0 ? (int)(40 * horas[h] / maximo) : 0;
+        printf("%02d:00  %6zu  %s\n", h, horas[h], string(barra, '#').c_str());
+    }
+}
+
+void ordenesDeRestauranteInteractivo(const Motor& motor) {
+    char nombre[MAX_NOMBRE];
+    unsigned long int fechaInicio, fechaFin;
+    cout << "\nIngrese el nombre del restaurante: ";
+    cin.getline(nombre, MAX_NOMBRE);
+    if (!pedirRango(motor, fechaInicio, fechaFin)) return;
+    ordenesDeRestaurante(motor, nombre, fechaInicio, fechaFin);
+}
+
+void demandaPorHoraInteractiva(const Motor& motor) {
+    char nombre[MAX_NOMBRE];
+    cout << "\nIngrese el nombre del platillo: ";
+    cin.getline(nombre, MAX_NOMBRE);
+    demandaPorHora(motor, nombre, 0, ULONG_MAX);
+}
+
+// --- VISTA: GRAFO BIPARTITO ---
+
+// BFS: Muestra cómo un platillo se reparte en diferentes restaurantes
+void ejecutarBFS(const Motor& motor, int idPlatillo) {
+    cout << "\n=== BÚSQUEDA BFS: DISTRIBUCIÓN DEL PLATILLO EN RESTAURANTES ===" << endl;
+    cout << "Platillo: " << motor.platillos.nombre(idPlatillo) << endl;
+    cout << string(60, '-') << endl;
+
+    shared_ptr<const ResultadoConsulta> resultado = motor.consultarPlatillo(idPlatillo);
+    const vector<pair<int, int>>& vecinos = resultado->restaurantes;
+
+    cout << "\nRestaurantes donde se ofrece este platillo:" << endl;
+    cout << string(60, '-') << endl;
+
+    int totalPedidos = 0;
+    for (size_t i = 0; i < vecinos.size(); i++) {
+        totalPedidos += vecinos[i].second;
+        cout << "[" << i + 1 << "] " << motor.restaurantes.nombre(vecinos[i].first)
+             << " - Pedidos: " << vecinos[i].second << endl;
+    }
+
+    cout << string(60, '-') << endl;
+    cout << "Total de restaurantes: " << vecinos.size() << endl;
+    cout << "Total de pedidos: " << totalPedidos << endl;
+    cout << string(60, '=') << endl;
+}
+
+void buscarPlatillo(const Motor& motor) {
+    char busqueda[MAX_NOMBRE];
+    cout << "\nIngrese el nombre del platillo a buscar: ";
+    cin.getline(busqueda, MAX_NOMBRE);
+
+    int idEncontrado = motor.platillos.buscar(busqueda);
+    if (idEncontrado != -1) {
+        ejecutarBFS(motor, idEncontrado);
+    } else {
+        cout << "Platillo no encontrado en la base de datos." << endl;
+    }
+}
+
+// Genera la matriz de adyacencia y la guarda en archivo
+void mostrarMatrizAdyacencia(const Motor& motor) {
+    cout << "\n=== MATRIZ DE ADYACENCIA ===" << endl;
+
+    int numPlatillos = motor.platillos.tamano();
+    int numRestaurantes = motor.restaurantes.tamano();
+    if (numPlatillos == 0 || numRestaurantes == 0) {
+        cout << "No hay suficientes datos." << endl;
+        return;
+    }
+
+    cout << "Generando matriz completa..." << endl;
+    cout << "Total Platillos: " << numPlatillos << ", Total Restaurantes: " << numRestaurantes << endl;
+
+    ofstream archivo("matriz_adyacencia.txt");
+    if (archivo.is_open()) {
+        archivo << "MATRIZ DE ADYACENCIA" << endl;
+        archivo << "Platillos: " << numPlatillos << ", Restaurantes: " << numRestaurantes << "\n" << endl;
+
+        archivo << "PLATILLO";
+        for (int j = 0; j < numRestaurantes; j++) {
+            archivo << "\t" << motor.restaurantes.nombre(j);
+        }
+        archivo << endl;
+
+        // Una fila a la vez: se vacía la lista del platillo en un renglón de pesos
+        auto generar = [&]() {
+            vector<int> fila(numRestaurantes);
+            for (int i = 0; i < numPlatillos; i++) {
+                fill(fila.begin(), fila.end(), 0);
+                for (NodoAdyacencia* temp = motor.grafo.vecinos(i); temp != nullptr; temp = temp->siguiente) {
+                    fila[temp->idDestino] = temp->peso;
+                }
+                archivo << motor.platillos.nombre(i);
+                for (int j = 0; j < numRestaurantes; j++) {
+                    archivo << "\t" << fila[j];
+                }
+                archivo << '\n';
+            }
+            archivo.flush();
+        };
+        if (motor.perfil) motor.perfil->medir("matrizAdyacencia", generar, [&]() { return (size_t)numPlatillos * numRestaurantes; });
+        else generar();
+        archivo.close();
+        cout << "Matriz guardada en 'matriz_adyacencia.txt'" << endl;
+    }
+}
+
+// Encuentra y muestra los restaurantes con mayor cantidad de solicitudes
+void restaurantesConMasSolicitudes(const Motor& motor) {
+    cout << "\n=== RESTAURANTES CON MAYOR CANTIDAD DE SOLICITUDES ===" << endl;
+
+    int numRestaurantes = motor.restaurantes.tamano();
+    vector<int> solicitudes(numRestaurantes, 0);
+    for (int i = 0; i < motor.platillos.tamano(); i++) {
+        for (NodoAdyacencia* temp = motor.grafo.vecinos(i); temp != nullptr; temp = temp->siguiente) {
+            solicitudes[temp->idDestino] += temp->peso;
+        }
+    }
+
+    vector<int> ranking(numRestaurantes);
+    for (int i = 0; i < numRestaurantes; i++) ranking[i] = i;
+    stable_sort(ranking.begin(), ranking.end(), [&solicitudes](int a, int b) {
+        return solicitudes[a] > solicitudes[b];
+    });
+
+    int topN = min(10, numRestaurantes);
+    cout << "\nTop " << topN << " restaurantes:\n" << endl;
+    for (int i = 0; i < topN; i++) {
+        cout << (i + 1) << ". " << motor.restaurantes.nombre(ranking[i])
+             << " - Solicitudes: " << solicitudes[ranking[i]] << endl;
+    }
+
+    ofstream archivo("restaurantes_solicitudes.txt");
+    if (archivo.is_open()) {
+        for (int i = 0; i < numRestaurantes; i++) {
+            archivo << (i + 1) << ". " << motor.restaurantes.nombre(ranking[i])
+                    << " - Solicitudes: " << solicitudes[ranking[i]] << endl;
+        }
+        archivo.close();
+        cout << "\nLista completa guardada en 'restaurantes_solicitudes.txt'" << endl;
+    }
+
+    cout << "================================" << endl;
+}
+
+// Muestra estadísticas del grafo
+void mostrarEstadisticas(const Motor& motor) {
+    cout << "\n=== ESTADÍSTICAS DEL GRAFO BIPARTITO ===" << endl;
+
+    int totalConexiones = 0;
+    int totalPedidos = 0;
+    for (int i = 0; i < motor.platillos.tamano(); i++) {
+        for (NodoAdyacencia* temp = motor.grafo.vecinos(i); temp != nullptr; temp = temp->siguiente) {
+            totalConexiones++;
+            totalPedidos += temp->peso;
+        }
+    }
+
+    cout << "Total de nodos: " << motor.platillos.tamano() + motor.restaurantes.tamano() << endl;
+    cout << "  - Platillos: " << motor.platillos.tamano() << endl;
+    cout << "  - Restaurantes: " << motor.restaurantes.tamano() << endl;
+    cout << "Total de conexiones: " << totalConexiones << endl;
+    cout << "Total de pedidos: " << totalPedidos << endl;
+    cout << "================================" << endl;
+}
+
+void listarPlatillos(const Motor& motor) {
+    cout << "\n=== LISTA DE PLATILLOS ===" << endl;
+    for (int i = 0; i < motor.platillos.tamano(); i++) {
+        cout << "- " << motor.platillos.nombre(i) << endl;
+    }
+    cout << "Total: " << motor.platillos.tamano() << " platillos" << endl;
+}
+
+void listarRestaurantes(const Motor& motor) {
+    cout << "\n=== LISTA DE RESTAURANTES ===" << endl;
+    for (int i = 0; i < motor.restaurantes.tamano(); i++) {
+        cout << "- " << motor.restaurantes.nombre(i) << endl;
+    }
+    cout << "Total: " << motor.restaurantes.tamano() << " restaurantes" << endl;
+}
+
+// Muestra las primeras 30 conexiones y guarda todas en archivo
+void mostrarTodasLasConexiones(const Motor& motor) {
+    cout << "\n=== TODAS LAS CONEXIONES DEL GRAFO ===" << endl;
+    cout << "Mostrando primeras 30 conexiones...\n" << endl;
+
+    int contador = 0;
+    int limite = 30;
+    for (int i = 0; i < motor.platillos.tamano() && contador < limite; i++) {
+        NodoAdyacencia* temp = motor.grafo.vecinos(i);
+        if (temp != nullptr) {
+            cout << motor.platillos.nombre(i) << " ->" << endl;
+            while (temp != nullptr && contador < limite) {
+                cout << "    " << motor.restaurantes.nombre(temp->idDestino)
+                     << " [Pedidos: " << temp->peso << "]" << endl;
+                contador++;
+                temp = temp->siguiente;
+            }
+            cout << endl;
+        }
+    }
+
+    if (contador >= limite) {
+        cout << "... (mostrando solo primeros " << limite << ")" << endl;
+    }
+
+    ofstream archivo("todas_conexiones.txt");
+    if (archivo.is_open()) {
+        for (int i = 0; i < motor.platillos.tamano(); i++) {
+            NodoAdyacencia* temp = motor.grafo.vecinos(i);
+            if (temp != nullptr) {
+                archivo << motor.platillos.nombre(i) << " ->" << endl;
+                while (temp != nullptr) {
+                    archivo << "    " << motor.restaurantes.nombre(temp->idDestino)
+                            << " [Pedidos: " << temp->peso << "]" << endl;
+                    temp = temp->siguiente;
+                }
+                archivo << endl;
+            }
+        }
+        archivo.close();
+        cout << "Todas las conexiones guardadas en 'todas_conexiones.txt'" << endl;
+    }
+}
+
+// --- LOTES INCREMENTALES ---
+
+// Muestra cuántas órdenes hay en el segmento principal y en cada lote pendiente de compactar
+void mostrarEstadoAlmacen(const Motor& motor) {
+    cout << "Segmento principal: " << motor.totalPrincipal() << " órdenes" << endl;
+    for (size_t s = 0; s < motor.segmentos.size(); s++) {
+        cout << "Lote " << s + 1 << ": " << motor.segmentos[s].indices.size() << " órdenes" << endl;
+    }
+    cout << "Compactaciones realizadas: " << motor.compactaciones;
+    if (motor.hiloCompactacion.joinable()) cout << " (una en curso)";
+    cout << endl;
+}
+
+// Ingiere un archivo nuevo como lote ordenado aparte
+void cargarLote(Motor& motor, const char* ruta) {
+    int nuevas = motor.agregarLote(ruta);
+    if (nuevas < 0) {
+        cout << "Error: No se pudo abrir '" << ruta << "'" << endl;
+        return;
+    }
+    cout << "✓ Lote '" << ruta << "' agregado: " << nuevas << " órdenes nuevas" << endl;
+    mostrarEstadoAlmacen(motor);
+}
+
+void cargarLoteInteractivo(Motor& motor) {
+    char ruta[MAX_NOMBRE];
+    cout << "\nIngrese la ruta del archivo con las órdenes nuevas: ";
+    cin.getline(ruta, MAX_NOMBRE);
+    cargarLote(motor, ruta);
+}
+
+// --- BOCETOS: PRECIOS Y PLATILLOS DISTINTOS ---
+
+// p50/p95 del ticket y platillos distintos (aproximados) por restaurante; todos van a archivo
+void mostrarBocetosRestaurantes(const Motor& motor) {
+    cout << "\n=== PRECIOS Y PLATILLOS DISTINTOS POR RESTAURANTE (aproximados) ===" << endl;
+
+    char busqueda[MAX_NOMBRE];
+    cout << "Restaurante a detallar (Enter para ver todos): ";
+    cin.getline(busqueda, MAX_NOMBRE);
+
+    if (busqueda[0] != '\0') {
+        int id = motor.restaurantes.buscar(busqueda);
+        if (id == -1) {
+            cout << "Restaurante no encontrado en la base de datos." << endl;
+            return;
+        }
+        const BocetosRestaurante& boceto = motor.bocetosRestaurante[id];
+        cout << busqueda << " - Pedidos: " << boceto.precios.n
+             << ", p50: $" << boceto.precios.cuantil(0.5) << ", p95: $" << boceto.precios.cuantil(0.95)
+             << ", Platillos distintos: ~" << (int)round(boceto.platillosDistintos()) << endl;
+        cout << "Platillos distintos por mes:" << endl;
+        for (size_t m = 0; m < boceto.platillosPorMes.size(); m++) {
+            int llave = boceto.platillosPorMes[m].first;
+            cout << "  " << llave / 12 << " " << NOMBRES_MES[llave % 12] << ": ~"
+                 << (int)round(boceto.platillosPorMes[m].second.estimar()) << endl;
+        }
+        return;
+    }
+
+    ofstream archivo("bocetos_restaurantes.txt");
+    for (int i = 0; i < motor.restaurantes.tamano(); i++) {
+        const BocetosRestaurante& boceto = motor.bocetosRestaurante[i];
+        char renglon[2 * MAX_NOMBRE];
+        snprintf(renglon, sizeof(renglon), "%s - Pedidos: %zu, p50: $%u, p95: $%u, Platillos distintos: ~%d",
+                 motor.restaurantes.nombre(i), boceto.precios.n, boceto.precios.cuantil(0.5),
+                 boceto.precios.cuantil(0.95), (int)round(boceto.platillosDistintos()));
+        if (i < 20) cout << renglon << endl;
+        if (archivo.is_open()) archivo << renglon << endl;
+    }
+    if (motor.restaurantes.tamano() > 20) cout << "... (mostrando solo primeros 20)" << endl;
+    if (archivo.is_open()) {
+        archivo.close();
+        cout << "Lista completa guardada en 'bocetos_restaurantes.txt'" << endl;
+    }
+}
+
+// p50/p95 del precio de cada platillo
+void mostrarPreciosPlatillos(const Motor& motor) {
+    cout << "\n=== PRECIOS POR PLATILLO (aproximados) ===" << endl;
+    for (int i = 0; i < motor.platillos.tamano(); i++) {
+        const BocetoKLL& precios = motor.preciosPlatillo[i];
+        cout << motor.platillos.nombre(i) << " - Pedidos: " << precios.n
+             << ", p50: $" << precios.cuantil(0.5) << ", p95: $" << precios.cuantil(0.95) << endl;
+    }
+}
+
+// --- CONJUNTOS (BITMAPS) ---
+
+// "y"/"and", "o"/"or", "menos"/"andnot" -> 'y', 'o', 'm'. Regresa false si no se reconoce
+bool leerOperacionConjunto(const char* texto, char& operacion) {
+    if (strcmp(texto, "y") == 0 || strcasecmp(texto, "and") == 0) operacion = 'y';
+    else if (strcmp(texto, "o") == 0 || strcasecmp(texto, "or") == 0) operacion = 'o';
+    else if (strcmp(texto, "menos") == 0 || strcasecmp(texto, "andnot") == 0) operacion = 'm';
+    else return false;
+    return true;
+}
+
+// Muestra el conjunto que resulta de combinar los nombres
+void mostrarConjunto(const Motor& motor, bool porPlatillo, char operacion, const vector<string>& nombres) {
+    const char* simbolo = operacion == 'y' ? " Y " : operacion == 'o' ? " O " : " MENOS ";
+    cout << "\n=== " << (porPlatillo ? "RESTAURANTES DE: " : "PLATILLOS DE: ");
+    for (size_t i = 0; i < nombres.size(); i++) cout << (i > 0 ? simbolo : "") << nombres[i];
+    cout << " ===" << endl;
+
+    BitmapRoaring resultado;
+    string desconocido;
+    if (!motor.combinarConjuntos(porPlatillo, operacion, nombres, resultado, desconocido)) {
+        cout << (porPlatillo ? "Platillo" : "Restaurante") << " no encontrado: " << desconocido << endl;
+        return;
+    }
+    const Diccionario& destino = porPlatillo ? motor.restaurantes : motor.platillos;
+    vector<uint32_t> ids = resultado.valores();
+    for (size_t i = 0; i < ids.size(); i++) cout << "- " << destino.nombre(ids[i]) << endl;
+    cout << "Cardinalidad: " << resultado.cardinalidad() << endl;
+}
+
+// Pide el tipo de consulta, la operación y los nombres (uno por línea, línea vacía para terminar)
+void consultaConjuntosInteractiva(const Motor& motor) {
+    cout << "\n=== CONSULTAS DE CONJUNTOS ===" << endl;
+    cout << "1. Restaurantes a partir de platillos" << endl;
+    cout << "2. Platillos a partir de restaurantes" << endl;
+    cout << "Seleccione: ";
+    int tipo;
+    char texto[MAX_NOMBRE];
+    cin >> tipo;
+    cout << "Operación (y | o | menos): ";
+    cin >> texto;
+    cin.ignore(10000, '\n');
+    char operacion;
+    if ((tipo != 1 && tipo != 2) || !leerOperacionConjunto(texto, operacion)) {
+        cout << "Opción no válida." << endl;
+        return;
+    }
+
+    vector<string> nombres;
+    cout << "Ingrese los nombres, uno por línea (\"*\" = todos; línea vacía para terminar):" << endl;
+    while (cin.getline(texto, MAX_NOMBRE) && texto[0] != '\0') nombres.push_back(texto);
+    if (nombres.empty()) return;
+    mostrarConjunto(motor, tipo == 1, operacion, nombres);
+}
+
+// --- SIMILITUD DE MENÚS (MINHASH / LSH) ---
+
+// K restaurantes más parecidos entre los candidatos de LSH, con lo que estima la firma al lado
+void mostrarSimilares(const Motor& motor, const char* nombre, int k) {
+    int id = motor.restaurantes.buscar(nombre);
+    if (id < 0) {
+        cout << "Restaurante no encontrado: " << nombre << endl;
+        return;
+    }
+    const IndiceSimilitud& indice = motor.similitud;
+    size_t candidatos;
+    vector<RestauranteSimilar> similares = indice.similares(id, k, &candidatos);
+
+    cout << "\n=== RESTAURANTES CON MENÚ PARECIDO A " << nombre << (indice.ponderado ? " (ponderado)" : "") << " ===" << endl;
+    for (size_t i = 0; i < similares.size(); i++) {
+        cout << i + 1 << ". " << motor.restaurantes.nombre(similares[i].idRestaurante)
+             << " - similitud " << similares[i].similitud
+             << " (firma MinHash: " << indice.estimar(id, similares[i].idRestaurante) << ")" << endl;
+    }
+    if (similares.empty()) cout << "Ningún restaurante comparte cubeta con este." << endl;
+    cout << "Candidatos comparados: " << candidatos << " de " << indice.tamano() - 1 << endl;
+}
+
+void similaresInteractivo(const Motor& motor) {
+    char nombre[MAX_NOMBRE];
+    int k;
+    cout << "\nIngrese el nombre del restaurante: ";
+    cin.getline(nombre, MAX_NOMBRE);
+    cout << "¿Cuántos restaurantes desea ver? (K): ";
+    cin >> k;
+    cin.ignore(10000, '\n');
+    mostrarSimilares(motor, nombre, k);
+}
+
+// Consulta cada restaurante por LSH y por fuerza bruta. El recall cuenta como acierto
+// cualquier resultado cuya similitud exacta alcance la del K-ésimo exacto (empates incluidos)
+void compararSimilitud(const Motor& motor, int k) {
+    const IndiceSimilitud& indice = motor.similitud;
+    double sumaRecall = 0, segundosLSH = 0, segundosExacto = 0;
+    size_t sumaCandidatos = 0;
+    int consultas = 0;
+
+    for (int id = 0; id < indice.tamano(); id++) {
+        if (indice.menus[id].empty()) continue;
+        auto t0 = chrono::steady_clock::now();
+        size_t candidatos;
+        vector<RestauranteSimilar> aproximados = indice.similares(id, k, &candidatos);
+        auto t1 = chrono::steady_clock::now();
+        vector<RestauranteSimilar> exactos = indice.similaresExactos(id, k);
+        auto t2 = chrono::steady_clock::now();
+        segundosLSH += chrono::duration<double>(t1 - t0).count();
+        segundosExacto += chrono::duration<double>(t2 - t1).count();
+        if (exactos.empty()) continue;
+
+        double umbral = exactos.back().similitud;
+        int aciertos = 0;
+        for (size_t i = 0; i < aproximados.size(); i++) {
+            if (indice.exacta(id, aproximados[i].idRestaurante) >= umbral) aciertos++;
+        }
+        sumaRecall += (double)aciertos / exactos.size();
+        sumaCandidatos += candidatos;
+        consultas++;
+    }
+
+    cout << "\n=== MINHASH/LSH CONTRA JACCARD EXACTA" << (indice.ponderado ? " PONDERADA" : "") << " ===" << endl;
+    cout << "Firmas de " << PERMUTACIONES_MINHASH << " valores, " << BANDAS_LSH << " bandas de " << FILAS_POR_BANDA << " filas" << endl;
+    if (consultas == 0) {
+        cout << "No hay restaurantes con platillos." << endl;
+        return;
+    }
+    cout << "Consultas: " << consultas << ", K = " << k << endl;
+    cout << "Recall@" << k << " promedio: " << sumaRecall / consultas << endl;
+    cout << "Candidatos promedio por consulta: " << (double)sumaCandidatos / consultas << " de " << indice.tamano() - 1 << endl;
+    cout << "Tiempo LSH: " << segundosLSH * 1000 << " ms, exacto: " << segundosExacto * 1000 << " ms" << endl;
+}
+
+// --- CACHÉ ---
+
+void mostrarEstadisticasCache(const Motor& motor) {
+    const CacheConsultas& cache = motor.cache;
+    size_t consultas = cache.aciertos + cache.fallos;
+    cout << "\n=== CACHÉ DE CONSULTAS ===" << endl;
+    cout << "Entradas: " << cache.entradas.size() << " (" << cache.usado << " de " << cache.capacidad << " líneas)" << endl;
+    cout << "Aciertos: " << cache.aciertos << endl;
+    cout << "Fallos: " << cache.fallos << endl;
+    if (consultas > 0) cout << "Tasa de aciertos: " << 100.0 * cache.aciertos / consultas << "%" << endl;
+    cout << "Invalidadas por lotes nuevos: " << cache.invalidadas << endl;
+    cout << "Época de ingesta: " << motor.epoca << endl;
+}
+
+// --- CARGA ---
+
+// Lee, ingiere, ordena e indexa la bitácora y después los lotes. Con 'cargador' corre en
+// segundo plano: avisa cada etapa y no imprime nada para no encimarse con el menú; los
+// errores se le pasan al cargador y el menú los muestra
+void cargarTodo(Motor& motor, const char* ruta, const vector<string>& fragmentos, bool comprimido,
+                const vector<const char*>& lotes, CargadorFondo* cargador) {
+    auto reportar = [cargador](const string& mensaje) {
+        if (cargador) cargador->reportarError(mensaje);
+        else cout << mensaje << endl;
+    };
+    // Sin --perfil cada fase solo se ejecuta; con --perfil se mide con los contadores
+    auto fase = [&motor](const char* nombre, function<void()> trabajo, function<size_t()> registros) {
+        if (motor.perfil) motor.perfil->medir(nombre, trabajo, registros);
+        else trabajo();
+    };
+    auto totalOrdenes = [&motor]() { return (size_t)motor.ordenes.total(); };
+
+    vector<Fragmento> partes;
+    fase("ingerir", [&]() {
+        if (fragmentos.empty()) {
+            // Una sola pasada: columnas, frecuencias, grafo y bocetos
+            if (motor.cargarArchivo(ruta)) motor.ingerir();
+            else reportar(string("Error: No se pudo abrir '") + ruta + "'");
+        } else {
+            // Cada fragmento se procesa (o se lee de su .frag) por separado y luego se fusionan
+            if (!obtenerFragmentos(fragmentos, motor, partes, motor.hilosOrdenamiento)) {
+                reportar("Error: No se pudo leer alguno de los fragmentos");
+            }
+            fusionarFragmentos(motor, partes);
+            if (motor.notificarAvance) motor.notificarAvance(motor.texto.size());
+        }
+    }, [&motor]() { return (size_t)motor.lineasLeidas; });
+    if (!cargador) {
+        for (size_t i = 0; i < partes.size(); i++) {
+            cout << "✓ Fragmento '" << partes[i].ruta << "': " << partes[i].fechas.size() << " órdenes ("
+                 << (partes[i].reutilizado ? "reutilizado" : "procesado") << ")" << endl;
+        }
+    }
+    // Los lotes vuelven a tocar el grafo, así que con lotes el grafo está listo hasta el final
+    if (cargador && lotes.empty()) cargador->avanzarEtapa(ETAPA_ORDENANDO);
+
+    // La fusión de fragmentos ya deja las órdenes ordenadas
+    if (fragmentos.empty()) fase("ordenarPorFecha", [&motor]() { motor.ordenarPorFecha(); }, totalOrdenes);
+    if (motor.perfil) {
+        // agregarArista va dentro de la ingesta; para verlo solo se repite sobre un grafo aparte
+        fase("agregarArista", [&motor]() {
+            GrafoBipartito prueba;
+            for (int i = 0; i < motor.ordenes.total(); i++) prueba.agregarArista(motor.ordenes.idPlatillo[i], motor.ordenes.idRestaurante[i]);
+        }, totalOrdenes);
+    }
+    fase("construirIndices", [&motor]() { motor.construirIndices(); }, totalOrdenes);
+    size_t antes = motor.bytesOrdenes();
+    if (comprimido) fase("comprimir", [&motor]() { motor.comprimir(); }, [&motor]() { return motor.totalOrdenadas(); });
+
+    if (cargador) {
+        for (size_t i = 0; i < lotes.size(); i++) {
+            if (motor.agregarLote(lotes[i]) < 0) reportar(string("Error: No se pudo abrir '") + lotes[i] + "'");
+        }
+        cargador->avanzarEtapa(ETAPA_LISTO);
+        return;
+    }
+
+    if (comprimido) {
+        cout << "✓ Almacén comprimido: " << antes / 1024 << " KB -> " << motor.bytesOrdenes() / 1024 << " KB" << endl;
+    }
+    cout << "✓ Archivo procesado: " << motor.lineasLeidas << " líneas leídas (tokenizador " << motor.nombreTokenizador << ")";
+    if (motor.lineasInvalidas > 0) cout << " (" << motor.lineasInvalidas << " con formato inválido)";
+    cout << endl;
+    cout << "✓ Órdenes ordenadas por fecha: " << motor.totalOrdenadas() << endl;
+    cout << "✓ Grafo bipartito construido: " << motor.platillos.tamano() + motor.restaurantes.tamano() << " nodos totales" << endl;
+
+    for (size_t i = 0; i < lotes.size(); i++) cargarLote(motor, lotes[i]);
+}
+
+// Vistas baratas que se contestan con el último resumen mientras la carga sigue
+void listarParcial(const vector<string>& nombres, const char* titulo, const char* tipo, const string& estado) {
+    cout << "\n=== LISTA DE " << titulo << " (cargando: " << estado << ") ===" << endl;
+    for (size_t i = 0; i < nombres.size(); i++) {
+        cout << "- " << nombres[i] << endl;
+    }
+    cout << "Total hasta ahora: " << nombres.size() << " " << tipo << endl;
+}
+
+void mostrarEstadisticasParciales(const ResumenCarga& resumen, const string& estado) {
+    cout << "\n=== ESTADÍSTICAS DE LO CARGADO HASTA AHORA (" << estado << ") ===" << endl;
+    cout << "Líneas leídas: " << resumen.lineasLeidas << endl;
+    cout << "Líneas con formato inválido: " << resumen.lineasInvalidas << endl;
+    cout << "Platillos: " << resumen.platillos.size() << endl;
+    cout << "Restaurantes: " << resumen.restaurantes.size() << endl;
+    cout << "================================" << endl;
+}
+
+// Etapa que necesita cada opción del menú antes de poder contestar
+int etapaNecesaria(int opcion) {
+    switch (opcion) {
+        case 5: case 6: case 10:
+            return ETAPA_INGIRIENDO; // se contestan con el resumen si la carga no ha terminado
+        case 1: case 2: case 3: case 12: case 13: case 14: case 17: case 18: case 19: case 20: case 21:
+            return ETAPA_LISTO;      // necesitan el orden por fecha (o modifican el motor)
+        default:
+            return ETAPA_ORDENANDO;  // necesitan el grafo, las frecuencias o los bocetos completos
+    }
+}
+
+// --- INTERFAZ ---
+
+// Errores que dejó el hilo de carga desde la última vez
+void mostrarErroresCarga(CargadorFondo* cargador) {
+    if (!cargador) return;
+    vector<string> errores = cargador->tomarErrores();
+    for (size_t i = 0; i < errores.size(); i++) cout << errores[i] << endl;
+}
+
+void menuPrincipal(Motor& motor, CargadorFondo* cargador) {
+    int opcion = 0;
+    while (true) {
+        mostrarErroresCarga(cargador);
+        cout << "\n=== MENÚ PRINCIPAL ===" << endl;
+        if (cargador && cargador->etapaActual() != ETAPA_LISTO) {
+            cout << "(Cargando en segundo plano: " << cargador->estado() << ")" << endl;
+        }
+        cout << "-- Órdenes por fecha --" << endl;
+        cout << "1. Ver primeros 10 registros" << endl;
+        cout << "2. Guardar ordenamiento completo (salida.txt)" << endl;
+        cout << "3. Buscar por rango de fechas" << endl;
+        cout << "-- Frecuencias --" << endl;
+        cout << "4. Platillos de más pedidos a menos" << endl;
+        cout << "12. Top platillos en un rango de fechas" << endl;
+        cout << "19. Órdenes de un restaurante en un rango de fechas" << endl;
+        cout << "20. Demanda de un platillo por hora" << endl;
+        cout << "-- Grafo bipartito --" << endl;
+        cout << "5. Ver lista de platillos" << endl;
+        cout << "6. Ver lista de restaurantes" << endl;
+        cout << "7. Buscar platillo (BFS)" << endl;
+        cout << "8. Restaurantes con mayor cantidad de solicitudes" << endl;
+        cout << "9. Mostrar matriz de adyacencia" << endl;
+        cout << "10. Mostrar estadísticas del grafo" << endl;
+        cout << "11. Mostrar todas las conexiones" << endl;
+        cout << "15. Precios (p50/p95) y platillos distintos por restaurante" << endl;
+        cout << "16. Precios (p50/p95) por platillo" << endl;
+        cout << "17. Consultas de conjuntos (y / o / menos)" << endl;
+        cout << "18. Restaurantes con menú parecido (MinHash/LSH)" << endl;
+        cout << "-- Lotes --" << endl;
+        cout << "13. Cargar lote de órdenes nuevas" << endl;
+        cout << "14. Estadísticas de la caché de consultas" << endl;
+        if (motor.perfil) cout << "21. Reporte de contadores de hardware (--perfil)" << endl;
+        cout << "0. Salir" << endl;
+        cout << "Seleccione: ";
+
+        if (!(cin >> opcion)) {
+            if (cin.eof()) break;
+            cout << "Entrada inválida." << endl;
+            cin.clear();
+            cin.ignore(10000, '\n');
+            continue;
+        }
+        cin.ignore(10000, '\n');
+
+        if (opcion == 0) break;
+
+        if (cargador && cargador->etapaActual() < ETAPA_ORDENANDO && etapaNecesaria(opcion) == ETAPA_INGIRIENDO) {
+            // Mientras se ingiere, las opciones baratas usan el último resumen publicado
+            shared_ptr<const ResumenCarga> resumen = cargador->ultimoResumen();
+            string estado = cargador->estado();
+            if (opcion == 5) listarParcial(resumen->platillos, "PLATILLOS", "platillos", estado);
+            else if (opcion == 6) listarParcial(resumen->restaurantes, "RESTAURANTES", "restaurantes", estado);
+            else mostrarEstadisticasParciales(*resumen, estado);
+            continue;
+        }
+        if (cargador) {
+            cargador->esperar(etapaNecesaria(opcion));
+            mostrarErroresCarga(cargador);
+        }
+
+        // Si terminó una compactación en segundo plano, se instala antes de contestar
+        if ((!cargador || cargador->etapaActual() == ETAPA_LISTO) && motor.publicarCompactacion()) {
+            cout << "(Compactación de lotes terminada)" << endl;
+        }
+
+        switch (opcion) {
+            case 1: mostrarPrimeros10(motor); break;
+            case 2: guardarOrdenamientoCompleto(motor); break;
+            case 3: busquedaInteractiva(motor); break;
+            case 4: imprimirFrecuencias(motor); break;
+            case 5: listarPlatillos(motor); break;
+            case 6: listarRestaurantes(motor); break;
+            case 7: buscarPlatillo(motor); break;
+            case 8: restaurantesConMasSolicitudes(motor); break;
+            case 9: mostrarMatrizAdyacencia(motor); break;
+            case 10: mostrarEstadisticas(motor); break;
+            case 11: mostrarTodasLasConexiones(motor); break;
+            case 12: analisisPorRangoInteractivo(motor); break;
+            case 13: cargarLoteInteractivo(motor); break;
+            case 14: mostrarEstadisticasCache(motor); break;
+            case 15: mostrarBocetosRestaurantes(motor); break;
+            case 16: mostrarPreciosPlatillos(motor); break;
+            case 17: consultaConjuntosInteractiva(motor); break;
+            case 18: similaresInteractivo(motor); break;
+            case 19: ordenesDeRestauranteInteractivo(motor); break;
+            case 20: demandaPorHoraInteractiva(motor); break;
+            case 21:
+                if (motor.perfil) motor.perfil->reportar();
+                else cout << "Ejecute con --perfil para medir las fases." << endl;
+                break;
+            default: cout << "Opción no válida. Por favor seleccione un número del 0 al 21." << endl;
+        }
+    }
+}
+
+// Tamaño del archivo en bytes, o -1 si no se puede abrir
+long tamanoArchivo(const char* ruta) {
+    ifstream archivo(ruta, ios::binary | ios::ate);
+    if (!archivo.is_open()) return -1;
+    return archivo.tellg();
+}
+
+int main(int argc, char* argv[]) {
+    const char* ruta = nullptr;
+    const char* subcomando = "menu";
+    vector<const char*> argumentos;
+    vector<const char*> lotes;
+    vector<string> fragmentos;
+    int hilos = 1;
+    bool comprimido = false;
+    bool ponderado = false;
+    bool perfilar = false;
+    int anio = ANIO_BASE_DEFECTO;
+    bool inferirAnio = false;
+    long capacidadCache = CAPACIDAD_CACHE_DEFECTO;
+    const char* tokenizador = "auto";
+    int formato = FORMATO_BITACORA;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--archivo") == 0 && i + 1 < argc) {
+            ruta = argv[++i];
+        } else if (strcmp(argv[i], "--lote") == 0 && i + 1 < argc) {
+            lotes.push_back(argv[++i]);
+        } else if (strcmp(argv[i], "--cache") == 0 && i + 1 < argc) {
+            capacidadCache = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--fragmentos") == 0 && i + 1 < argc) {
+            if (!listarBitacoras(argv[++i], fragmentos)) {
+                cout << "Error: No se pudo abrir '" << argv[i] << "'" << endl;
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--perfil") == 0) {
+            perfilar = true;
+        } else if (strcmp(argv[i], "--ponderado") == 0) {
+            ponderado = true;
+        } else if (strcmp(argv[i], "--anio") == 0 && i + 1 < argc) {
+            anio = atoi(argv[++i]);
+            if (anio < 1970) {
+                cout << "Error: El año debe ser 1970 o posterior" << endl;
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--inferir-anio") == 0) {
+            inferirAnio = true;
+        } else if (strcmp(argv[i], "--formato") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "barras") == 0) {
+                formato = FORMATO_BARRAS;
+            } else if (strcmp(argv[i], "bitacora") != 0) {
+                cout << "Error: Formato desconocido '" << argv[i] << "' (bitacora o barras)" << endl;
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--tokenizador") == 0 && i + 1 < argc) {
+            tokenizador = argv[++i];
+        } else if (strcmp(argv[i], "--comprimido") == 0) {
+            comprimido = true;
+        } else if (strcmp(argv[i], "--hilos") == 0 && i + 1 < argc) {
+            hilos = atoi(argv[++i]);
+        } else {
+            argumentos.push_back(argv[i]);
+        }
+    }
+    if (!argumentos.empty()) subcomando = argumentos[0];
+
+    Motor motor;
+    motor.hilosOrdenamiento = hilos;
+    motor.similitudPonderada = ponderado;
+    Perfilador perfil;
+    if (perfilar) motor.perfil = &perfil;
+    motor.cache.capacidad = capacidadCache > 0 ? capacidadCache : 0;
+    motor.mascaras = elegirTokenizador(tokenizador, motor.nombreTokenizador);
+    if (motor.mascaras == nullptr) {
+        cout << "Error: Tokenizador desconocido '" << tokenizador << "' (auto, avx2, sse2 o escalar)" << endl;
+        return 1;
+    }
+    if (strcmp(tokenizador, "auto") != 0 && strcmp(tokenizador, motor.nombreTokenizador) != 0) {
+        cout << "Nota: El procesador no soporta el tokenizador " << tokenizador << "; se usa "
+             << motor.nombreTokenizador << endl;
+    }
+    motor.calendario.configurar(anio, inferirAnio);
+    motor.formato = formato;
+
+    // Igual que entregafinal_listas: bitacora.txt y si no existe orders.txt
+    long tamano;
+    if (!fragmentos.empty()) {
+        tamano = 0;
+        for (size_t i = 0; i < fragmentos.size(); i++) tamano += tamanoArchivo(fragmentos[i].c_str());
+        cout << "Leyendo " << fragmentos.size() << " fragmentos de la bitácora..." << endl;
+    } else if (ruta != nullptr) {
+        tamano = tamanoArchivo(ruta);
+        if (tamano < 0) {
+            cout << "Error: No se pudo abrir '" << ruta << "'" << endl;
+            return 1;
+        }
+        cout << "Leyendo archivo '" << ruta << "'..." << endl;
+    } else if ((tamano = tamanoArchivo("bitacora.txt")) >= 0) {
+        ruta = "bitacora.txt";
+        cout << "Leyendo archivo 'bitacora.txt'..." << endl;
+    } else if ((tamano = tamanoArchivo("orders.txt")) >= 0) {
+        ruta = "orders.txt";
+        cout << "Nota: Usando 'orders.txt' (no se encontró 'bitacora.txt')" << endl;
+    } else {
+        cout << "Error: No se pudo abrir 'bitacora.txt' ni 'orders.txt'" << endl;
+        return 1;
+    }
+
+    if (strcmp(subcomando, "menu") == 0) {
+        // El menú aparece de inmediato; la carga sigue en otro hilo
+        CargadorFondo cargador;
+        cargador.bytesTotales = tamano;
+        motor.notificarAvance = [&cargador, &motor](size_t bytes) {
+            cargador.publicar(resumirCarga(motor, bytes));
+        };
+        cargador.iniciar([&motor, ruta, &fragmentos, comprimido, &lotes, &cargador]() {
+            cargarTodo(motor, ruta, fragmentos, comprimido, lotes, &cargador);
+        });
+        menuPrincipal(motor, &cargador);
+        if (cargador.etapaActual() != ETAPA_LISTO) cout << "Esperando a que termine la carga para salir..." << endl;
+        cargador.esperar(ETAPA_LISTO);
+        mostrarErroresCarga(&cargador);
+        return 0;
+    }
+
+    cargarTodo(motor, ruta, fragmentos, comprimido, lotes, nullptr);
+
+    if (strcmp(subcomando, "ordenes") == 0) {
+        mostrarPrimeros10(motor);
+        guardarOrdenamientoCompleto(motor);
+        if (argumentos.size() >= 3) {
+            unsigned long int fechaInicio, fechaFin;
+            if (!leerRango(motor, argumentos[1], argumentos[2], fechaInicio, fechaFin)) return 1;
+            shared_ptr<const ResultadoConsulta> resultado = buscarPorRango(motor, fechaInicio, fechaFin);
+            guardarBusqueda(*resultado, fechaInicio, fechaFin);
+        }
+    } else if (strcmp(subcomando, "frecuencias") == 0) {
+        imprimirFrecuencias(motor);
+    } else if (strcmp(subcomando, "top") == 0 && argumentos.size() >= 3) {
+        int k = argumentos.size() >= 4 ? atoi(argumentos[3]) : 10;
+        unsigned long int fechaInicio, fechaFin;
+        if (!leerRango(motor, argumentos[1], argumentos[2], fechaInicio, fechaFin)) return 1;
+        topPlatillosEnRango(motor, fechaInicio, fechaFin, k);
+    } else if (strcmp(subcomando, "conjuntos") == 0 && argumentos.size() >= 4) {
+        bool desdePlatillos = strcmp(argumentos[1], "platillos") == 0;
+        if (!desdePlatillos && strcmp(argumentos[1], "restaurantes") != 0) {
+            cout << "Tipo desconocido: " << argumentos[1] << " (use platillos | restaurantes)" << endl;
+            cout << "Uso: conjuntos platillos|restaurantes y|o|menos nombre..." << endl;
+            return 1;
+        }
+        char operacion;
+        if (!leerOperacionConjunto(argumentos[2], operacion)) {
+            cout << "Operación desconocida: " << argumentos[2] << " (use y | o | menos)" << endl;
+            return 1;
+        }
+        vector<string> nombres(argumentos.begin() + 3, argumentos.end());
+        mostrarConjunto(motor, desdePlatillos, operacion, nombres);
+    } else if (strcmp(subcomando, "restaurante") == 0 && argumentos.size() >= 4) {
+        unsigned long int fechaInicio, fechaFin;
+        if (!leerRango(motor, argumentos[2], argumentos[3], fechaInicio, fechaFin)) return 1;
+        ordenesDeRestaurante(motor, argumentos[1], fechaInicio, fechaFin);
+    } else if (strcmp(subcomando, "demanda-hora") == 0 && argumentos.size() >= 2) {
+        unsigned long int fechaInicio = 0, fechaFin = ULONG_MAX;
+        if (argumentos.size() >= 4
+            && !leerRango(motor, argumentos[2], argumentos[3], fechaInicio, fechaFin)) return 1;
+        demandaPorHora(motor, argumentos[1], fechaInicio, fechaFin);
+    } else if (strcmp(subcomando, "similares") == 0 && argumentos.size() >= 2) {
+        mostrarSimilares(motor, argumentos[1], argumentos.size() >= 3 ? atoi(argumentos[2]) : 5);
+    } else if (strcmp(subcomando, "similitud-bench") == 0) {
+        compararSimilitud(motor, argumentos.size() >= 2 ? atoi(argumentos[1]) : 5);
+    } else if (strcmp(subcomando, "grafo") == 0) {
+        mostrarEstadisticas(motor);
+        restaurantesConMasSolicitudes(motor);
+        mostrarMatrizAdyacencia(motor);
+    } else {
+        cout << "Subcomando desconocido: " << subcomando << endl;
+        cout << "Use: menu | ordenes [inicio fin] | frecuencias | grafo | top inicio fin [K]"
+             << " | conjuntos platillos|restaurantes y|o|menos nombre..."
+             << " | restaurante nombre inicio fin | demanda-hora platillo [inicio fin]"
+             << " | similares restaurante [K] | similitud-bench [K]" << endl;
+        return 1;
+    }
+
+    if (perfilar) perfil.reportar();
+    return 0;
+}
+
+/* comando terminal para compilar y ejecutar el programa
+g++ -std=c++17 -O2 -pthread motor_unificado.cpp -o motor_unificado
+./motor_unificado
+./motor_unificado ordenes 0213000000 0302235959
+./motor_unificado top 0213000000 0302235959 10
+./motor_unificado ordenes "Feb 13" "Mar 2"
+./motor_unificado --anio 2023 --inferir-anio ordenes "2023 Dic 24 18:00" "2024 ene 2"
+./motor_unificado --hilos 0 ordenes
+./motor_unificado --comprimido
+./motor_unificado --lote nuevas.txt ordenes
+./motor_unificado --tokenizador escalar ordenes
+./motor_unificado --hilos 0 --fragmentos bitacoras/ ordenes
+./motor_unificado conjuntos platillos y "Curry de Pollo" "Fideua"
+./motor_unificado conjuntos restaurantes menos "*" "El Barzon"
+./motor_unificado restaurante "The Rustic Spoon" "Dic 1" "Dic 24"
+./motor_unificado demanda-hora "Fideua"
+./motor_unificado similares "El Barzon" 5
+./motor_unificado --perfil grafo
+./motor_unificado --ponderado similitud-bench 10
+*/
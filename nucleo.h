@@ -0,0 +1,972 @@
+/*
+NÚCLEO COMPARTIDO DEL MOTOR DE ÓRDENES
+Reúne en un solo lugar lo que primerEntrega, entrega_arboles y entregafinal_listas
+hacían cada uno por su cuenta:
+- Lee la bitácora completa una sola vez y la parsea en una sola pasada
+- Guarda las órdenes en columnas (fecha, restaurante, platillo, precio, línea original)
+- En la misma pasada cuenta la frecuencia de cada platillo y construye el grafo
+  bipartito Platillo -> Restaurante con listas de adyacencia
+- Después ordena un índice de las órdenes por fecha para las búsquedas por rango
+
+Autores: Equipo SProblema 5
+ - Franco Varela Villegas - A01199186
+ - Nerik Nieto Gutiérrez - A01739652
+ - Eduardo Mora Howard - A00829920
+*/
+
+#ifndef NUCLEO_H
+#define NUCLEO_H
+
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <climits>
+#include <functional>
+#include <type_traits>
+
+#include "matriz_wavelet.h"
+#include "ordenamiento_paralelo.h"
+#include "almacen_comprimido.h"
+#include "almacen_lsm.h"
+#include "cache_consultas.h"
+#include "bocetos.h"
+#include "tokenizador_simd.h"
+#include "conjuntos_roaring.h"
+#include "similitud_minhash.h"
+#include "perfil_hardware.h"
+#include "marca_tiempo.h"
+#include "esquema_bitacora.h"
+
+using namespace std;
+
+#define MAX_NOMBRE 256
+#define LINEAS_POR_AVANCE 65536 // cada cuántas líneas se avisa el avance de la ingesta
+
+// --- PARSEO DE UNA LÍNEA DE LA BITÁCORA ---
+// Formato: "Feb 13 19:25:24 R:El Barzon O:ensalada Griega(140) "
+
+// Campos de una línea ya separados (los nombres apuntan dentro de la línea original)
+struct RegistroLinea {
+    int mes, dia, segundosDelDia; // como vienen en la línea (sin año)
+    int anio;                     // lo pone el Calendario del motor junto con la fecha
+    unsigned long int fecha;      // segundos desde 1970
+    const char* restaurante;
+    int lenRestaurante;
+    const char* platillo;
+    int lenPlatillo;
+    unsigned long int precio;
+};
+
+// Guarda los campos de la fecha si están en rango (el día contra el mes lo revisa el Calendario)
+inline bool guardarFecha(RegistroLinea& reg, int mes, int dia, int horas, int minutos, int segundos) {
+    if (mes < 1 || mes > 12 || dia < 1 || dia > 31 || horas > 23 || minutos > 59 || segundos > 59) return false;
+    reg.mes = mes;
+    reg.dia = dia;
+    reg.segundosDelDia = horas * 3600 + minutos * 60 + segundos;
+    return true;
+}
+
+// Quita espacios al final de un nombre
+inline int recortarEspacios(const char* inicio, int len) {
+    while (len > 0 && inicio[len - 1] == ' ') len--;
+    return len;
+}
+
+// Separa todos los campos de una línea con un esquema de esquema_bitacora.h.
+// Regresa false si la línea no tiene el formato esperado
+template <typename EsquemaLinea = EsquemaBitacora>
+inline bool parsearLinea(const char* linea, RegistroLinea& reg) {
+    ValoresLinea v;
+    if (!EsquemaLinea::extraer(linea, v)) return false;
+    reg.restaurante = v.textos[CAMPO_RESTAURANTE];
+    reg.lenRestaurante = v.largos[CAMPO_RESTAURANTE];
+    reg.platillo = v.textos[CAMPO_PLATILLO];
+    reg.lenPlatillo = v.largos[CAMPO_PLATILLO];
+    reg.precio = v.numeros[CAMPO_PRECIO];
+    return guardarFecha(reg, v.numeros[CAMPO_MES], v.numeros[CAMPO_DIA], v.numeros[CAMPO_HORAS],
+                        v.numeros[CAMPO_MINUTOS], v.numeros[CAMPO_SEGUNDOS]);
+}
+
+// Cuenta los dígitos seguidos a partir de p
+inline int contarDigitos(const char* p) {
+    int n = 0;
+    while ((unsigned char)(p[n] - '0') <= 9) n++;
+    return n;
+}
+
+// Igual que parsearLinea pero con las posiciones que ya encontró el tokenizador SIMD:
+// no vuelve a buscar "R:", " O:" ni el paréntesis. Si la línea no tiene la forma
+// esperada regresa false y quien llama usa parsearLinea
+inline bool parsearTokens(const char* texto, const EstadoLinea& e, RegistroLinea& reg) {
+    if (e.marcaO == 0 || e.cierra == 0) return false;
+    const char* linea = texto + e.inicio;
+
+    // Fecha
+    int mes = numeroMes(linea);
+    if (mes == 0 || linea[3] != ' ') return false;
+    const char* p = linea + 4;
+    int lenDia = contarDigitos(p);
+    if (p[lenDia] != ' ') return false;
+    int dia = leerDigitos(p, lenDia);
+    p += lenDia + 1;
+    int horas = leerDigitos(p, texto + e.horaMinuto - p);
+    p = texto + e.horaMinuto + 1;
+    int minutos = leerDigitos(p, texto + e.minutoSegundo - p);
+    p = texto + e.minutoSegundo + 1;
+    int segundos = leerDigitos(p, contarDigitos(p));
+    if (dia < 0 || horas < 0 || minutos < 0 || segundos < 0) return false;
+    if (!guardarFecha(reg, mes, dia, horas, minutos, segundos)) return false;
+
+    // Restaurante: de "R:" al espacio antes de "O:"
+    const char* inicio = texto + e.marcaR + 1;
+    while (*inicio == ' ') inicio++;
+    const char* fin = texto + e.marcaO - 2;
+    if (fin < inicio) return false;
+    reg.restaurante = inicio;
+    reg.lenRestaurante = recortarEspacios(inicio, fin - inicio);
+
+    // Platillo: de "O:" al último paréntesis
+    inicio = texto + e.marcaO + 1;
+    while (*inicio == ' ') inicio++;
+    fin = texto + e.abre;
+    if (fin < inicio) return false;
+    reg.platillo = inicio;
+    reg.lenPlatillo = recortarEspacios(inicio, fin - inicio);
+
+    // Precio: los dígitos entre los paréntesis
+    int precio = leerDigitos(fin + 1, e.cierra - e.abre - 1);
+    if (precio < 0) return false;
+    reg.precio = precio;
+
+    return reg.lenRestaurante > 0 && reg.lenPlatillo > 0;
+}
+
+// Hora (0-23) de una fecha en segundos
+inline int horaDeFecha(unsigned long int fecha) {
+    return fecha % SEGUNDOS_DIA / 3600;
+}
+
+// Reconstruye una línea en el formato con el que se leyó (--formato) a partir de sus campos
+// (el año no se escribe)
+inline void escribirLinea(char* destino, size_t tamano, int formato, unsigned long int fecha,
+                          const char* restaurante, const char* platillo, unsigned int precio) {
+    FechaCivil f = descomponerFecha(fecha);
+    if (formato == FORMATO_BARRAS) {
+        snprintf(destino, tamano, "%02d/%02d %02d:%02d:%02d | %s | %s | %u",
+                 f.dia, f.mes, f.horas, f.minutos, f.segundos, restaurante, platillo, precio);
+    } else {
+        snprintf(destino, tamano, "%s %d %d:%d:%d R:%s O:%s(%u) ",
+                 NOMBRES_MES[f.mes - 1], f.dia, f.horas, f.minutos, f.segundos,
+                 restaurante, platillo, precio);
+    }
+}
+
+// --- DICCIONARIO DE NOMBRES ---
+// Asigna un ID consecutivo a cada nombre distinto (restaurantes o platillos)
+struct Diccionario {
+    vector<string> nombres;
+    unordered_map<string, int> ids;
+
+    int obtenerOcrear(const char* nombre, int len) {
+        string llave(nombre, len);
+        auto it = ids.find(llave);
+        if (it != ids.end()) return it->second;
+        int nuevoId = nombres.size();
+        ids.emplace(llave, nuevoId);
+        nombres.push_back(llave);
+        return nuevoId;
+    }
+
+    // Regresa el ID de un nombre o -1 si no existe
+    int buscar(const char* nombre) const {
+        auto it = ids.find(nombre);
+        return it == ids.end() ? -1 : it->second;
+    }
+
+    int tamano() const { return nombres.size(); }
+    const char* nombre(int id) const { return nombres[id].c_str(); }
+};
+
+// --- ALMACÉN DE ÓRDENES (COLUMNAS) ---
+// Cada orden es una posición en todas las columnas
+struct AlmacenOrdenes {
+    vector<unsigned long int> fechas;
+    vector<int> idRestaurante;
+    vector<int> idPlatillo;
+    vector<unsigned int> precios;
+    vector<size_t> inicioLinea; // posición de la línea original dentro del texto
+
+    void agregar(unsigned long int fecha, int restaurante, int platillo, unsigned int precio, size_t linea) {
+        fechas.push_back(fecha);
+        idRestaurante.push_back(restaurante);
+        idPlatillo.push_back(platillo);
+        precios.push_back(precio);
+        inicioLinea.push_back(linea);
+    }
+
+    int total() const { return fechas.size(); }
+};
+
+// --- GRAFO BIPARTITO (LISTAS ENLAZADAS) ---
+
+// Nodo de la Lista Enlazada (Representa una arista/conexión)
+struct NodoAdyacencia {
+    int idDestino;      // ID del restaurante
+    int peso;           // Frecuencia de pedidos
+    NodoAdyacencia* siguiente;
+
+    NodoAdyacencia(int id) {
+        idDestino = id;
+        peso = 1;
+        siguiente = nullptr;
+    }
+};
+
+// Grafo DIRIGIDO Platillo -> Restaurante. La lista de cada platillo se indexa por su ID
+struct GrafoBipartito {
+    vector<NodoAdyacencia*> listas;
+
+    GrafoBipartito() {}
+    GrafoBipartito(const GrafoBipartito&) = delete;
+    GrafoBipartito& operator=(const GrafoBipartito&) = delete;
+
+    ~GrafoBipartito() {
+        for (size_t i = 0; i < listas.size(); i++) {
+            NodoAdyacencia* actual = listas[i];
+            while (actual != nullptr) {
+                NodoAdyacencia* temp = actual;
+                actual = actual->siguiente;
+                delete temp;
+            }
+        }
+    }
+
+    // Busca si existe una conexión en la lista enlazada
+    NodoAdyacencia* buscarArista(int idPlatillo, int idRestaurante) const {
+        if (idPlatillo >= (int)listas.size()) return nullptr;
+        NodoAdyacencia* actual = listas[idPlatillo];
+        while (actual != nullptr) {
+            if (actual->idDestino == idRestaurante) return actual;
+            actual = actual->siguiente;
+        }
+        return nullptr;
+    }
+
+    // Suma 'peso' pedidos a la arista o la agrega al inicio de la lista
+    void agregarArista(int idPlatillo, int idRestaurante, int peso = 1) {
+        if (idPlatillo >= (int)listas.size()) listas.resize(idPlatillo + 1, nullptr);
+        NodoAdyacencia* existente = buscarArista(idPlatillo, idRestaurante);
+        if (existente != nullptr) {
+            existente->peso += peso;
+        } else {
+            NodoAdyacencia* nuevo = new NodoAdyacencia(idRestaurante);
+            nuevo->peso = peso;
+            nuevo->siguiente = listas[idPlatillo];
+            listas[idPlatillo] = nuevo;
+        }
+    }
+
+    NodoAdyacencia* vecinos(int idPlatillo) const {
+        return idPlatillo < (int)listas.size() ? listas[idPlatillo] : nullptr;
+    }
+};
+
+// --- MOTOR ---
+// Dueño de todas las estructuras; se llenan juntas en una sola lectura del archivo
+struct Motor {
+    string texto;                    // contenido de la bitácora (y de los lotes agregados)
+    AlmacenOrdenes ordenes;
+    Diccionario restaurantes;
+    Diccionario platillos;
+    vector<int> frecuenciaPlatillo;  // pedidos por ID de platillo
+    GrafoBipartito grafo;
+    vector<BocetosRestaurante> bocetosRestaurante; // precios y platillos distintos por restaurante
+    vector<BocetoKLL> preciosPlatillo;             // precios por platillo
+    vector<BitmapRoaring> restaurantesDePlatillo;  // conjunto de restaurantes de cada platillo
+    vector<BitmapRoaring> platillosDeRestaurante;  // conjunto de platillos de cada restaurante
+    IndiceSimilitud similitud;       // firmas MinHash y cubetas LSH de los menús
+    bool similitudPonderada = false; // pesar cada platillo por sus pedidos
+    Perfilador* perfil = nullptr;    // con --perfil: contadores de hardware por fase
+    vector<int> ordenPorFecha;       // segmento principal: índices ordenados por fecha
+    MatrizWavelet platillosPorFecha; // IDs de platillo en el orden del segmento principal
+    IndiceCompuesto porRestaurante;  // (restaurante, fecha) -> posición en el segmento principal
+    IndiceCompuesto porPlatillo;     // (platillo, fecha) -> posición en el segmento principal
+    vector<Segmento> segmentos;      // lotes agregados después, cada uno ordenado por su cuenta
+    int lineasLeidas = 0;
+    int lineasInvalidas = 0;
+    int hilosOrdenamiento = 1;       // 1 = serial, 0 = todos los núcleos
+    bool modoComprimido = false;     // el segmento principal vive solo en 'comprimidas'
+    AlmacenComprimido comprimidas;
+    mutable CacheConsultas cache;    // resultados de consultas repetidas
+    unsigned long int epoca = 0;     // época de ingesta: sube con cada lote
+    function<void(size_t)> notificarAvance; // opcional: recibe los bytes ya procesados
+    const char* nombreTokenizador = "escalar";
+    FuncionMascaras mascaras = elegirTokenizador("auto", nombreTokenizador); // AVX2, SSE2 o escalar
+    Calendario calendario;           // año de cada línea (--anio, --inferir-anio)
+    int formato = FORMATO_BITACORA;  // esquema de las líneas (--formato)
+
+    // Compactación en segundo plano
+    thread hiloCompactacion;
+    atomic<bool> compactacionLista{false};
+    ResultadoCompactacion compactacion;
+    int compactaciones = 0;
+
+    Motor() {}
+    Motor(const Motor&) = delete;
+    Motor& operator=(const Motor&) = delete;
+
+    ~Motor() {
+        if (hiloCompactacion.joinable()) hiloCompactacion.join();
+    }
+
+    // Agrega el archivo completo al final del texto. Cada '\n' se vuelve '\0' al ingerir
+    // para usar las líneas como cadenas; el texto siempre termina en un '\0' extra.
+    // El archivo nuevo va después de ese '\0': si el anterior no terminaba en '\n', ese
+    // '\0' es el que cierra su última línea
+    bool cargarArchivo(const char* ruta, size_t& inicio) {
+        ifstream archivo(ruta, ios::binary);
+        if (!archivo.is_open()) return false;
+        archivo.seekg(0, ios::end);
+        size_t tamano = archivo.tellg();
+        archivo.seekg(0, ios::beg);
+        inicio = texto.size();
+        texto.resize(inicio + tamano + 1, '\0');
+        archivo.read(&texto[inicio], tamano);
+        archivo.close();
+        return true;
+    }
+
+    bool cargarArchivo(const char* ruta) {
+        size_t inicio;
+        return cargarArchivo(ruta, inicio);
+    }
+
+    // Agrega una orden a todas las estructuras
+    void registrar(const RegistroLinea& reg, size_t inicio) {
+        int idRestaurante = restaurantes.obtenerOcrear(reg.restaurante, reg.lenRestaurante);
+        int idPlatillo = platillos.obtenerOcrear(reg.platillo, reg.lenPlatillo);
+
+        ordenes.agregar(reg.fecha, idRestaurante, idPlatillo, reg.precio, inicio);
+
+        if (idPlatillo >= (int)frecuenciaPlatillo.size()) frecuenciaPlatillo.resize(idPlatillo + 1, 0);
+        frecuenciaPlatillo[idPlatillo]++;
+
+        grafo.agregarArista(idPlatillo, idRestaurante);
+
+        // Bocetos de los vértices: tamaño fijo sin importar cuántas órdenes lleguen
+        if (idRestaurante >= (int)bocetosRestaurante.size()) bocetosRestaurante.resize(idRestaurante + 1);
+        if (idPlatillo >= (int)preciosPlatillo.size()) preciosPlatillo.resize(idPlatillo + 1);
+        BocetosRestaurante& boceto = bocetosRestaurante[idRestaurante];
+        boceto.precios.agregar(reg.precio);
+        boceto.deMes(reg.anio, reg.mes).agregar(idPlatillo);
+        preciosPlatillo[idPlatillo].agregar(reg.precio);
+    }
+
+    // Termina la línea que va de estado.inicio a 'fin' (un '\n' o el final del texto).
+    // Las posiciones del tokenizador solo sirven para el formato de la bitácora
+    template <typename EsquemaLinea>
+    void procesarLinea(const EstadoLinea& estado, size_t fin) {
+        char* linea = &texto[estado.inicio];
+        texto[fin] = '\0';
+        if (fin > estado.inicio && texto[fin - 1] == '\r') texto[fin - 1] = '\0';
+        if (*linea == '\0') return;
+
+        lineasLeidas++;
+        RegistroLinea reg;
+        bool separada;
+        if constexpr (is_same<EsquemaLinea, EsquemaBitacora>::value) {
+            separada = parsearTokens(texto.data(), estado, reg) || parsearLinea(linea, reg);
+        } else {
+            separada = parsearLinea<EsquemaLinea>(linea, reg);
+        }
+        if (separada && calendario.marcaDeLinea(reg.mes, reg.dia, reg.segundosDelDia, reg.anio, reg.fecha)) {
+            registrar(reg, estado.inicio);
+        } else {
+            lineasInvalidas++;
+        }
+        if (notificarAvance && lineasLeidas % LINEAS_POR_AVANCE == 0) notificarAvance(fin + 1);
+    }
+
+    // Recorre el texto una sola vez (desde 'pos') con el esquema de 'formato'
+    void ingerir(size_t pos = 0) {
+        if (formato == FORMATO_BARRAS) ingerirConEsquema<EsquemaBarras>(pos);
+        else ingerirConEsquema<EsquemaBitacora>(pos);
+    }
+
+    // Recorre el texto una sola vez (desde 'pos') llenando columnas, frecuencias y grafo.
+    // Con el formato de la bitácora el texto se lee en bloques de 64 bytes y de cada bloque
+    // solo se visitan los caracteres estructurales que marcó el tokenizador. Los demás
+    // esquemas no usan esas posiciones: solo se buscan los saltos de línea con memchr
+    template <typename EsquemaLinea>
+    void ingerirConEsquema(size_t pos) {
+        size_t fin = texto.size() - 1; // el último byte es el '\0' agregado
+        EstadoLinea estado;
+        estado.reiniciar(pos);
+        if constexpr (is_same<EsquemaLinea, EsquemaBitacora>::value) {
+            char relleno[64];
+            for (size_t bloque = pos; bloque < fin; bloque += 64) {
+                MascarasBloque m;
+                if (fin - bloque >= 64) {
+                    mascaras(texto.data() + bloque, m);
+                } else {
+                    // Último bloque incompleto: se copia a un bloque lleno de ceros
+                    memset(relleno, 0, sizeof(relleno));
+                    memcpy(relleno, texto.data() + bloque, fin - bloque);
+                    mascaras(relleno, m);
+                }
+
+                uint64_t estructurales = m.saltos | m.dosPuntos | m.abre | m.cierra;
+                while (estructurales != 0) {
+                    int bit = __builtin_ctzll(estructurales);
+                    estructurales &= estructurales - 1;
+                    uint64_t marca = 1ULL << bit;
+                    size_t i = bloque + bit;
+                    if (m.saltos & marca) {
+                        procesarLinea<EsquemaLinea>(estado, i);
+                        estado.reiniciar(i + 1);
+                    } else if (m.dosPuntos & marca) {
+                        estado.dosPuntos(texto.data(), i);
+                    } else {
+                        estado.parentesis(i, (m.abre & marca) != 0);
+                    }
+                }
+            }
+        } else {
+            while (estado.inicio < fin) {
+                const char* salto = (const char*)memchr(texto.data() + estado.inicio, '\n', fin - estado.inicio);
+                if (salto == nullptr) break;
+                size_t i = salto - texto.data();
+                procesarLinea<EsquemaLinea>(estado, i);
+                estado.reiniciar(i + 1);
+            }
+        }
+        if (estado.inicio < fin) procesarLinea<EsquemaLinea>(estado, fin);
+        if (notificarAvance) notificarAvance(fin);
+    }
+
+    // Ordena los índices por fecha; en empates se conserva el orden del archivo
+    void ordenarPorFecha() {
+        int total = ordenes.total();
+        ordenPorFecha.resize(total);
+        for (int i = 0; i < total; i++) ordenPorFecha[i] = i;
+        ordenarIndicesParalelo(ordenPorFecha, ordenes.fechas, hilosOrdenamiento);
+    }
+
+    // Construye los índices que dependen del orden por fecha
+    void construirIndices() {
+        vector<int> secuencia(ordenPorFecha.size());
+        for (size_t i = 0; i < ordenPorFecha.size(); i++) {
+            secuencia[i] = ordenes.idPlatillo[ordenPorFecha[i]];
+        }
+        platillosPorFecha.construir(secuencia, platillos.tamano());
+        construirCompuestos(ordenPorFecha, ordenes.idRestaurante, ordenes.idPlatillo, ordenes.fechas,
+                            porRestaurante, porPlatillo);
+        construirConjuntos();
+        construirSimilitud();
+    }
+
+    // Menú de cada restaurante (platillo, pedidos) a partir del grafo, e índice MinHash/LSH
+    void construirSimilitud() {
+        vector<vector<pair<int, int>>> menus(restaurantes.tamano());
+        for (int p = 0; p < platillos.tamano(); p++) {
+            for (NodoAdyacencia* v = grafo.vecinos(p); v != nullptr; v = v->siguiente) {
+                menus[v->idDestino].push_back(make_pair(p, v->peso));
+            }
+        }
+        similitud.construir(menus, similitudPonderada);
+    }
+
+    // Índices (restaurante, fecha) y (platillo, fecha) de un principal dado por 'orden'
+    // (posiciones dentro de las columnas recibidas)
+    void construirCompuestos(const vector<int>& orden, const vector<int>& idRestaurante, const vector<int>& idPlatillo,
+                             const vector<unsigned long int>& fechas,
+                             IndiceCompuesto& destinoRestaurante, IndiceCompuesto& destinoPlatillo) const {
+        destinoRestaurante.construir(orden.size(), restaurantes.tamano(),
+            [&](size_t p) { return idRestaurante[orden[p]]; }, [&](size_t p) { return fechas[orden[p]]; });
+        destinoPlatillo.construir(orden.size(), platillos.tamano(),
+            [&](size_t p) { return idPlatillo[orden[p]]; }, [&](size_t p) { return fechas[orden[p]]; });
+    }
+
+    // Pasa las aristas del grafo a los bitmaps de los dos lados
+    void construirConjuntos() {
+        restaurantesDePlatillo.assign(platillos.tamano(), BitmapRoaring());
+        platillosDeRestaurante.assign(restaurantes.tamano(), BitmapRoaring());
+        for (int p = 0; p < platillos.tamano(); p++) {
+            for (NodoAdyacencia* v = grafo.vecinos(p); v != nullptr; v = v->siguiente) agregarAConjuntos(p, v->idDestino);
+        }
+    }
+
+    void agregarAConjuntos(int idPlatillo, int idRestaurante) {
+        if (idPlatillo >= (int)restaurantesDePlatillo.size()) restaurantesDePlatillo.resize(idPlatillo + 1);
+        if (idRestaurante >= (int)platillosDeRestaurante.size()) platillosDeRestaurante.resize(idRestaurante + 1);
+        restaurantesDePlatillo[idPlatillo].agregar(idRestaurante);
+        platillosDeRestaurante[idRestaurante].agregar(idPlatillo);
+    }
+
+    // Combina los conjuntos de varios nombres. desdePlatillos: los nombres son platillos y el
+    // resultado son restaurantes; si no, al revés. operacion: 'y' (AND), 'o' (OR) o
+    // 'm' (el primero menos los demás). El nombre "*" es el conjunto de todos.
+    // Regresa false y deja el nombre en 'desconocido' si alguno no existe
+    bool combinarConjuntos(bool desdePlatillos, char operacion, const vector<string>& nombres,
+                           BitmapRoaring& resultado, string& desconocido) const {
+        const Diccionario& diccionario = desdePlatillos ? platillos : restaurantes;
+        const vector<BitmapRoaring>& conjuntos = desdePlatillos ? restaurantesDePlatillo : platillosDeRestaurante;
+        int universo = desdePlatillos ? restaurantes.tamano() : platillos.tamano();
+
+        for (size_t i = 0; i < nombres.size(); i++) {
+            BitmapRoaring actual;
+            if (nombres[i] == "*") {
+                for (int id = 0; id < universo; id++) actual.agregar(id);
+            } else {
+                int id = diccionario.buscar(nombres[i].c_str());
+                if (id < 0 || id >= (int)conjuntos.size()) {
+                    desconocido = nombres[i];
+                    return false;
+                }
+                actual = conjuntos[id];
+            }
+
+            if (i == 0) resultado = actual;
+            else if (operacion == 'y') resultado = BitmapRoaring::interseccion(resultado, actual);
+            else if (operacion == 'o') resultado = BitmapRoaring::unir(resultado, actual);
+            else resultado = BitmapRoaring::diferencia(resultado, actual);
+        }
+        return true;
+    }
+
+    // Libera el texto y las columnas (todo está ya en el almacén comprimido)
+    void liberarColumnas() {
+        string().swap(texto);
+        vector<unsigned long int>().swap(ordenes.fechas);
+        vector<int>().swap(ordenes.idRestaurante);
+        vector<int>().swap(ordenes.idPlatillo);
+        vector<unsigned int>().swap(ordenes.precios);
+        vector<size_t>().swap(ordenes.inicioLinea);
+    }
+
+    // Pasa las órdenes ordenadas al almacén comprimido y libera el texto y las columnas.
+    // Las líneas se reconstruyen después a partir de los campos
+    void comprimir() {
+        comprimidas.construir(ordenes.fechas, ordenes.idRestaurante, ordenes.idPlatillo, ordenes.precios,
+                              ordenPorFecha, restaurantes.tamano(), platillos.tamano());
+        modoComprimido = true;
+        vector<int>().swap(ordenPorFecha);
+        liberarColumnas();
+    }
+
+    // --- LOTES INCREMENTALES ---
+
+    // Lee un archivo nuevo, lo ingiere y lo deja como un segmento ordenado aparte.
+    // Regresa cuántas órdenes trae el lote, o -1 si no se pudo abrir
+    int agregarLote(const char* ruta) {
+        esperarCompactacion(); // la compactación lee las columnas que aquí crecen
+        size_t inicio;
+        if (!cargarArchivo(ruta, inicio)) return -1;
+        int primera = ordenes.total();
+        ingerir(inicio);
+
+        Segmento segmento;
+        for (int i = primera; i < ordenes.total(); i++) segmento.indices.push_back(i);
+        ordenarIndicesParalelo(segmento.indices, ordenes.fechas, hilosOrdenamiento);
+        int nuevas = segmento.indices.size();
+        if (nuevas > 0) {
+            // Nueva época: la caché solo descarta lo que este lote puede cambiar
+            vector<bool> platillosDelLote(platillos.tamano(), false);
+            for (int i = primera; i < ordenes.total(); i++) {
+                platillosDelLote[ordenes.idPlatillo[i]] = true;
+                agregarAConjuntos(ordenes.idPlatillo[i], ordenes.idRestaurante[i]);
+            }
+            epoca++;
+            cache.invalidarLote(ordenes.fechas[segmento.indices.front()], ordenes.fechas[segmento.indices.back()],
+                                platillosDelLote, epoca);
+            segmentos.push_back(move(segmento));
+            construirSimilitud(); // las firmas dependen de todo el menú; rehacerlas es barato
+        }
+
+        if ((int)segmentos.size() >= MAX_SEGMENTOS) iniciarCompactacion();
+        return nuevas;
+    }
+
+    // Mezcla el principal con los segmentos actuales en otro hilo
+    void iniciarCompactacion() {
+        if (hiloCompactacion.joinable() || segmentos.empty()) return;
+
+        // Se copian los índices de los segmentos: el vector 'segmentos' puede crecer mientras tanto
+        vector<vector<int>> corridas;
+        for (size_t s = 0; s < segmentos.size(); s++) corridas.push_back(segmentos[s].indices);
+        compactacion = ResultadoCompactacion();
+        compactacion.segmentosIncluidos = segmentos.size();
+
+        hiloCompactacion = thread([this, corridas]() {
+            if (modoComprimido) compactarComprimido(corridas);
+            else compactarNormal(corridas);
+            compactacionLista = true;
+        });
+    }
+
+    void compactarNormal(const vector<vector<int>>& corridas) {
+        vector<const vector<int>*> fuentes;
+        fuentes.push_back(&ordenPorFecha);
+        for (size_t c = 0; c < corridas.size(); c++) fuentes.push_back(&corridas[c]);
+        compactacion.principal = mezclarCorridas(fuentes, ordenes.fechas);
+
+        vector<int> secuencia(compactacion.principal.size());
+        for (size_t i = 0; i < secuencia.size(); i++) secuencia[i] = ordenes.idPlatillo[compactacion.principal[i]];
+        compactacion.platillos.construir(secuencia, platillos.tamano());
+        construirCompuestos(compactacion.principal, ordenes.idRestaurante, ordenes.idPlatillo, ordenes.fechas,
+                            compactacion.porRestaurante, compactacion.porPlatillo);
+    }
+
+    // En modo comprimido se decodifica el principal, se mezcla con los lotes y se vuelve a comprimir
+    void compactarComprimido(const vector<vector<int>>& corridas) {
+        size_t total = comprimidas.total;
+        for (size_t c = 0; c < corridas.size(); c++) total += corridas[c].size();
+
+        vector<unsigned long int> fechas;
+        vector<int> idRestaurante, idPlatillo;
+        vector<unsigned int> precios;
+        fechas.reserve(total);
+        idRestaurante.reserve(total);
+        idPlatillo.reserve(total);
+        precios.reserve(total);
+
+        OrdenDecodificada bloque[ORDENES_POR_BLOQUE];
+        size_t bloqueCargado = (size_t)-1;
+        size_t p = 0;
+        vector<size_t> pos(corridas.size(), 0);
+        while (fechas.size() < total) {
+            if (p < comprimidas.total && p / ORDENES_POR_BLOQUE != bloqueCargado) {
+                bloqueCargado = p / ORDENES_POR_BLOQUE;
+                comprimidas.decodificarBloque(bloqueCargado, bloque);
+            }
+            // -1 = segmento principal; en empates gana el principal y luego el lote más viejo
+            int elegida = p < comprimidas.total ? -1 : -2;
+            unsigned long int mejor = elegida == -1 ? bloque[p % ORDENES_POR_BLOQUE].fecha : 0;
+            for (size_t c = 0; c < corridas.size(); c++) {
+                if (pos[c] == corridas[c].size()) continue;
+                unsigned long int f = ordenes.fechas[corridas[c][pos[c]]];
+                if (elegida == -2 || f < mejor) {
+                    elegida = c;
+                    mejor = f;
+                }
+            }
+            if (elegida == -1) {
+                const OrdenDecodificada& o = bloque[p % ORDENES_POR_BLOQUE];
+                fechas.push_back(o.fecha);
+                idRestaurante.push_back(o.idRestaurante);
+                idPlatillo.push_back(o.idPlatillo);
+                precios.push_back(o.precio);
+                p++;
+            } else {
+                int id = corridas[elegida][pos[elegida]++];
+                fechas.push_back(ordenes.fechas[id]);
+                idRestaurante.push_back(ordenes.idRestaurante[id]);
+                idPlatillo.push_back(ordenes.idPlatillo[id]);
+                precios.push_back(ordenes.precios[id]);
+            }
+        }
+
+        vector<int> identidad(total);
+        for (size_t i = 0; i < total; i++) identidad[i] = i;
+        compactacion.comprimidas.construir(fechas, idRestaurante, idPlatillo, precios, identidad,
+                                           restaurantes.tamano(), platillos.tamano());
+        compactacion.platillos.construir(idPlatillo, platillos.tamano());
+        construirCompuestos(identidad, idRestaurante, idPlatillo, fechas, compactacion.porRestaurante, compactacion.porPlatillo);
+    }
+
+    // Instala el resultado de la compactación si ya terminó. Se llama desde el hilo del menú
+    bool publicarCompactacion() {
+        if (!compactacionLista) return false;
+        if (hiloCompactacion.joinable()) hiloCompactacion.join();
+        compactacionLista = false;
+
+        if (modoComprimido) comprimidas = move(compactacion.comprimidas);
+        else ordenPorFecha.swap(compactacion.principal);
+        platillosPorFecha = move(compactacion.platillos);
+        porRestaurante = move(compactacion.porRestaurante);
+        porPlatillo = move(compactacion.porPlatillo);
+        segmentos.erase(segmentos.begin(), segmentos.begin() + compactacion.segmentosIncluidos);
+        compactacion = ResultadoCompactacion();
+        compactaciones++;
+
+        // En modo comprimido las columnas solo guardan lotes; si ya no queda ninguno se liberan
+        if (modoComprimido && segmentos.empty()) liberarColumnas();
+        return true;
+    }
+
+    // Bloquea hasta que termine la compactación en curso y la instala
+    void esperarCompactacion() {
+        if (hiloCompactacion.joinable()) {
+            hiloCompactacion.join();
+            publicarCompactacion();
+        }
+    }
+
+    // --- CONSULTAS SOBRE TODOS LOS SEGMENTOS ---
+
+    // Memoria de las órdenes ordenadas (columnas + índice + texto, o bloques comprimidos)
+    size_t bytesOrdenes() const {
+        size_t bytes = texto.size() + ordenes.fechas.size() * (sizeof(unsigned long int) + 2 * sizeof(int)
+                       + sizeof(unsigned int) + sizeof(size_t)) + ordenPorFecha.size() * sizeof(int);
+        for (size_t s = 0; s < segmentos.size(); s++) bytes += segmentos[s].indices.size() * sizeof(int);
+        bytes += porRestaurante.bytesUsados() + porPlatillo.bytesUsados();
+        if (modoComprimido) bytes += comprimidas.bytesUsados();
+        return bytes;
+    }
+
+    size_t totalPrincipal() const {
+        return modoComprimido ? comprimidas.total : ordenPorFecha.size();
+    }
+
+    size_t totalOrdenadas() const {
+        size_t total = totalPrincipal();
+        for (size_t s = 0; s < segmentos.size(); s++) total += segmentos[s].indices.size();
+        return total;
+    }
+
+    // Posiciones [desde, hasta) del segmento principal con fecha dentro de [fechaInicio, fechaFin]
+    void rangoPrincipal(unsigned long int fechaInicio, unsigned long int fechaFin, size_t& desde, size_t& hasta) const {
+        if (modoComprimido) {
+            desde = comprimidas.buscarPosicion(fechaInicio, false);
+            hasta = comprimidas.buscarPosicion(fechaFin, true);
+            if (hasta < desde) hasta = desde;
+        } else {
+            rangoEnIndices(ordenPorFecha, ordenes.fechas, fechaInicio, fechaFin, desde, hasta);
+        }
+    }
+
+    // Órdenes con fecha dentro de [fechaInicio, fechaFin] en todos los segmentos
+    size_t contarEnRango(unsigned long int fechaInicio, unsigned long int fechaFin) const {
+        size_t desde, hasta;
+        rangoPrincipal(fechaInicio, fechaFin, desde, hasta);
+        size_t total = hasta - desde;
+        for (size_t s = 0; s < segmentos.size(); s++) {
+            rangoEnIndices(segmentos[s].indices, ordenes.fechas, fechaInicio, fechaFin, desde, hasta);
+            total += hasta - desde;
+        }
+        return total;
+    }
+
+    // Llama visitar(n, linea) en orden de fecha para las primeras 'limite' órdenes del rango,
+    // mezclando el segmento principal con los lotes. En modo comprimido cada bloque del
+    // principal se decodifica una sola vez. Regresa cuántas se visitaron
+    template <typename Visitante>
+    size_t recorrerRango(unsigned long int fechaInicio, unsigned long int fechaFin, size_t limite, Visitante visitar) const {
+        size_t p, finP;
+        rangoPrincipal(fechaInicio, fechaFin, p, finP);
+        vector<size_t> pos(segmentos.size()), finSeg(segmentos.size());
+        for (size_t s = 0; s < segmentos.size(); s++) {
+            rangoEnIndices(segmentos[s].indices, ordenes.fechas, fechaInicio, fechaFin, pos[s], finSeg[s]);
+        }
+
+        OrdenDecodificada bloque[ORDENES_POR_BLOQUE];
+        size_t bloqueCargado = (size_t)-1;
+        char buffer[2 * MAX_NOMBRE + 64];
+        size_t n = 0;
+        while (n < limite) {
+            // -1 = segmento principal; en empates gana el principal y luego el lote más viejo
+            int elegida = -2;
+            unsigned long int mejor = 0;
+            if (p < finP) {
+                if (modoComprimido) {
+                    if (p / ORDENES_POR_BLOQUE != bloqueCargado) {
+                        bloqueCargado = p / ORDENES_POR_BLOQUE;
+                        comprimidas.decodificarBloque(bloqueCargado, bloque);
+                    }
+                    mejor = bloque[p % ORDENES_POR_BLOQUE].fecha;
+                } else {
+                    mejor = ordenes.fechas[ordenPorFecha[p]];
+                }
+                elegida = -1;
+            }
+            for (size_t s = 0; s < segmentos.size(); s++) {
+                if (pos[s] == finSeg[s]) continue;
+                unsigned long int f = ordenes.fechas[segmentos[s].indices[pos[s]]];
+                if (elegida == -2 || f < mejor) {
+                    elegida = s;
+                    mejor = f;
+                }
+            }
+            if (elegida == -2) break;
+
+            if (elegida >= 0) {
+                visitar(n, linea(segmentos[elegida].indices[pos[elegida]++]));
+            } else if (modoComprimido) {
+                const OrdenDecodificada& o = bloque[p % ORDENES_POR_BLOQUE];
+                escribirLinea(buffer, sizeof(buffer), formato, o.fecha, restaurantes.nombre(o.idRestaurante),
+                              platillos.nombre(o.idPlatillo), o.precio);
+                visitar(n, (const char*)buffer);
+                p++;
+            } else {
+                visitar(n, linea(ordenPorFecha[p++]));
+            }
+            n++;
+        }
+        return n;
+    }
+
+    // Cuántas veces aparece cada platillo en los lotes dentro del rango (proporcional a los lotes)
+    unordered_map<int, size_t> conteoLotesEnRango(unsigned long int fechaInicio, unsigned long int fechaFin) const {
+        unordered_map<int, size_t> conteo;
+        for (size_t s = 0; s < segmentos.size(); s++) {
+            size_t desde, hasta;
+            rangoEnIndices(segmentos[s].indices, ordenes.fechas, fechaInicio, fechaFin, desde, hasta);
+            for (size_t i = desde; i < hasta; i++) conteo[ordenes.idPlatillo[segmentos[s].indices[i]]]++;
+        }
+        return conteo;
+    }
+
+    // Top K platillos del rango. La matriz wavelet cubre el principal; los lotes se cuentan
+    // aparte. Un platillo fuera del top K del principal y ausente en los lotes no puede
+    // superar a ninguno de ese top K, así que basta revisar esos candidatos
+    vector<ConteoPlatillo> topPlatillosEnRango(unsigned long int fechaInicio, unsigned long int fechaFin, int k) const {
+        size_t desde, hasta;
+        rangoPrincipal(fechaInicio, fechaFin, desde, hasta);
+        vector<ConteoPlatillo> top = platillosPorFecha.topK(desde, hasta, k);
+        unordered_map<int, size_t> lotes = conteoLotesEnRango(fechaInicio, fechaFin);
+        if (lotes.empty()) return top;
+
+        for (size_t i = 0; i < top.size(); i++) lotes.emplace(top[i].idPlatillo, 0);
+        top.clear();
+        for (auto it = lotes.begin(); it != lotes.end(); ++it) {
+            top.push_back({it->first, platillosPorFecha.frecuencia(desde, hasta, it->first) + it->second});
+        }
+        sort(top.begin(), top.end(), [](const ConteoPlatillo& a, const ConteoPlatillo& b) {
+            if (a.pedidos != b.pedidos) return a.pedidos > b.pedidos;
+            return a.idPlatillo < b.idPlatillo;
+        });
+        if ((int)top.size() > k) top.resize(k);
+        return top;
+    }
+
+    size_t frecuenciaEnRango(unsigned long int fechaInicio, unsigned long int fechaFin, int idPlatillo) const {
+        size_t desde, hasta;
+        rangoPrincipal(fechaInicio, fechaFin, desde, hasta);
+        size_t total = platillosPorFecha.frecuencia(desde, hasta, idPlatillo);
+        unordered_map<int, size_t> lotes = conteoLotesEnRango(fechaInicio, fechaFin);
+        auto it = lotes.find(idPlatillo);
+        return it == lotes.end() ? total : total + it->second;
+    }
+
+    int distintosEnRango(unsigned long int fechaInicio, unsigned long int fechaFin) const {
+        size_t desde, hasta;
+        rangoPrincipal(fechaInicio, fechaFin, desde, hasta);
+        int distintos = platillosPorFecha.distintos(desde, hasta);
+        unordered_map<int, size_t> lotes = conteoLotesEnRango(fechaInicio, fechaFin);
+        for (auto it = lotes.begin(); it != lotes.end(); ++it) {
+            if (platillosPorFecha.frecuencia(desde, hasta, it->first) == 0) distintos++;
+        }
+        return distintos;
+    }
+
+    // --- CONSULTAS POR RESTAURANTE O PLATILLO (ÍNDICE COMPUESTO) ---
+
+    // Órdenes de los lotes con ese restaurante (o platillo) y fecha en el rango, en orden de
+    // fecha; en empates, el lote más viejo primero
+    vector<int> lotesDeId(bool esRestaurante, int id, unsigned long int fechaInicio, unsigned long int fechaFin) const {
+        const vector<int>& ids = esRestaurante ? ordenes.idRestaurante : ordenes.idPlatillo;
+        vector<int> encontradas;
+        for (size_t s = 0; s < segmentos.size(); s++) {
+            size_t desde, hasta;
+            rangoEnIndices(segmentos[s].indices, ordenes.fechas, fechaInicio, fechaFin, desde, hasta);
+            for (size_t i = desde; i < hasta; i++) {
+                if (ids[segmentos[s].indices[i]] == id) encontradas.push_back(segmentos[s].indices[i]);
+            }
+        }
+        const vector<unsigned long int>& fechas = ordenes.fechas;
+        stable_sort(encontradas.begin(), encontradas.end(), [&fechas](int a, int b) { return fechas[a] < fechas[b]; });
+        return encontradas;
+    }
+
+    // Como recorrerRango pero solo con las órdenes de un restaurante (esRestaurante) o platillo.
+    // El principal se consulta con el índice compuesto: dos búsquedas binarias
+    template <typename Visitante>
+    size_t recorrerPorId(bool esRestaurante, int id, unsigned long int fechaInicio, unsigned long int fechaFin,
+                         size_t limite, Visitante visitar) const {
+        const IndiceCompuesto& indice = esRestaurante ? porRestaurante : porPlatillo;
+        size_t k, finK;
+        indice.rango(id, fechaInicio, fechaFin, k, finK);
+        vector<int> lotes = lotesDeId(esRestaurante, id, fechaInicio, fechaFin);
+        size_t l = 0;
+
+        OrdenDecodificada bloque[ORDENES_POR_BLOQUE];
+        size_t bloqueCargado = (size_t)-1;
+        char buffer[2 * MAX_NOMBRE + 64];
+        size_t n = 0;
+        while (n < limite && (k < finK || l < lotes.size())) {
+            // En empates gana el principal, igual que en recorrerRango
+            if (l == lotes.size() || (k < finK && fechaDeLlave(indice.llaves[k]) <= ordenes.fechas[lotes[l]])) {
+                size_t p = indice.posiciones[k++];
+                if (modoComprimido) {
+                    if (p / ORDENES_POR_BLOQUE != bloqueCargado) {
+                        bloqueCargado = p / ORDENES_POR_BLOQUE;
+                        comprimidas.decodificarBloque(bloqueCargado, bloque);
+                    }
+                    const OrdenDecodificada& o = bloque[p % ORDENES_POR_BLOQUE];
+                    escribirLinea(buffer, sizeof(buffer), formato, o.fecha, restaurantes.nombre(o.idRestaurante),
+                                  platillos.nombre(o.idPlatillo), o.precio);
+                    visitar(n, (const char*)buffer);
+                } else {
+                    visitar(n, linea(ordenPorFecha[p]));
+                }
+            } else {
+                visitar(n, linea(lotes[l++]));
+            }
+            n++;
+        }
+        return n;
+    }
+
+    // Pedidos de un platillo por hora del día dentro del rango; solo lee las llaves del índice
+    vector<size_t> demandaPorHora(int idPlatillo, unsigned long int fechaInicio, unsigned long int fechaFin) const {
+        vector<size_t> horas(24, 0);
+        size_t desde, hasta;
+        porPlatillo.rango(idPlatillo, fechaInicio, fechaFin, desde, hasta);
+        for (size_t k = desde; k < hasta; k++) horas[horaDeFecha(fechaDeLlave(porPlatillo.llaves[k])) % 24]++;
+        vector<int> lotes = lotesDeId(false, idPlatillo, fechaInicio, fechaFin);
+        for (size_t i = 0; i < lotes.size(); i++) horas[horaDeFecha(ordenes.fechas[lotes[i]]) % 24]++;
+        return horas;
+    }
+
+    // --- CONSULTAS CON CACHÉ ---
+
+    // Líneas de todas las órdenes del rango, ya ordenadas; se calculan una vez por época
+    shared_ptr<const ResultadoConsulta> consultarRango(unsigned long int fechaInicio, unsigned long int fechaFin) const {
+        string llave = CacheConsultas::llaveRango(fechaInicio, fechaFin);
+        shared_ptr<const ResultadoConsulta> guardado = cache.buscar(llave, epoca);
+        if (guardado != nullptr) return guardado;
+
+        shared_ptr<ResultadoConsulta> resultado = make_shared<ResultadoConsulta>();
+        recorrerRango(fechaInicio, fechaFin, ULONG_MAX, [&resultado](size_t, const char* linea) {
+            resultado->lineas.push_back(linea);
+        });
+        cache.guardar({llave, 'R', fechaInicio, fechaFin, -1, epoca, resultado->lineas.size() + 1, resultado});
+        return resultado;
+    }
+
+    // Restaurantes donde se vende el platillo con sus pedidos (recorrido de su lista)
+    shared_ptr<const ResultadoConsulta> consultarPlatillo(int idPlatillo) const {
+        string llave = CacheConsultas::llavePlatillo(idPlatillo);
+        shared_ptr<const ResultadoConsulta> guardado = cache.buscar(llave, epoca);
+        if (guardado != nullptr) return guardado;
+
+        shared_ptr<ResultadoConsulta> resultado = make_shared<ResultadoConsulta>();
+        for (NodoAdyacencia* temp = grafo.vecinos(idPlatillo); temp != nullptr; temp = temp->siguiente) {
+            resultado->restaurantes.push_back(make_pair(temp->idDestino, temp->peso));
+        }
+        cache.guardar({llave, 'P', 0, 0, idPlatillo, epoca, resultado->restaurantes.size() + 1, resultado});
+        return resultado;
+    }
+
+    const char* linea(int idOrden) const {
+        return texto.c_str() + ordenes.inicioLinea[idOrden];
+    }
+};
+
+#endif
@@ -0,0 +1,170 @@
+/*
+ORDENAMIENTO PARALELO POR FECHA
+Mergesort multivía sobre bloques ordenados por hilo:
+1. El arreglo de índices se parte en un bloque por hilo y cada hilo lo ordena con stable_sort
+2. La salida se parte en tantas rebanadas como hilos. Para cada corte se busca cuántos
+   elementos de cada bloque quedan antes (co-rango), así que cada hilo mezcla los k
+   bloques a la vez solo dentro de su rebanada: una sola ronda, todos los hilos ocupados
+En los empates de fecha la mezcla toma primero del bloque de la izquierda, que siempre
+tiene las posiciones menores del archivo; así el resultado es estable e idéntico al de
+stable_sort en un solo hilo.
+
+Autores: Equipo SProblema 5
+ - Franco Varela Villegas - A01199186
+ - Nerik Nieto Gutiérrez - A01739652
+ - Eduardo Mora Howard - A00829920
+*/
+
+#ifndef ORDENAMIENTO_PARALELO_H
+#define ORDENAMIENTO_PARALELO_H
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <climits>
+
+using namespace std;
+
+// Debajo de este tamaño no vale la pena crear hilos
+#define MIN_POR_HILO 16384
+
+// Número de hilos a usar: 0 significa "todos los núcleos disponibles"
+inline int resolverHilos(int hilos) {
+    if (hilos > 0) return hilos;
+    int disponibles = thread::hardware_concurrency();
+    return disponibles > 0 ? disponibles : 1;
+}
+
+// Co-rango: cuántos elementos de cada bloque [cortes[j], cortes[j+1]) van antes de la
+// posición 'rango' de la salida. Se busca la menor llave v con al menos 'rango' elementos
+// <= v; todo lo menor que v va antes, y de los iguales se toman primero los de los
+// bloques de la izquierda. 'division[j]' queda como posición absoluta en 'indices'
+inline void coRango(const vector<int>& indices, const vector<unsigned long int>& llaves,
+                    const vector<size_t>& cortes, size_t rango, vector<size_t>& division) {
+    auto valorMenor = [&llaves](unsigned long int v, int i) { return v < llaves[i]; };
+    auto menorValor = [&llaves](int i, unsigned long int v) { return llaves[i] < v; };
+    int bloques = cortes.size() - 1;
+    auto contarHasta = [&](unsigned long int v) {
+        size_t total = 0;
+        for (int j = 0; j < bloques; j++) {
+            total += upper_bound(indices.begin() + cortes[j], indices.begin() + cortes[j + 1], v, valorMenor)
+                   - (indices.begin() + cortes[j]);
+        }
+        return total;
+    };
+
+    division.assign(cortes.begin(), cortes.end() - 1);
+    if (rango == 0) return;
+
+    unsigned long int bajo = 0, alto = ULONG_MAX;
+    while (bajo < alto) {
+        unsigned long int medio = bajo + (alto - bajo) / 2;
+        if (contarHasta(medio) >= rango) alto = medio;
+        else bajo = medio + 1;
+    }
+
+    size_t faltan = rango;
+    vector<size_t> iguales(bloques);
+    for (int j = 0; j < bloques; j++) {
+        auto inicio = indices.begin() + cortes[j];
+        auto fin = indices.begin() + cortes[j + 1];
+        auto primero = lower_bound(inicio, fin, bajo, menorValor);
+        division[j] = primero - indices.begin();
+        iguales[j] = upper_bound(primero, fin, bajo, valorMenor) - primero;
+        faltan -= primero - inicio;
+    }
+    for (int j = 0; j < bloques && faltan > 0; j++) {
+        size_t tomar = min(faltan, iguales[j]);
+        division[j] += tomar;
+        faltan -= tomar;
+    }
+}
+
+// Mezcla los tramos [desde[j], hasta[j]) de todos los bloques en 'salida' con un montículo
+// de cabezas; en empates sale primero el bloque de la izquierda
+inline void mezclarRebanada(const vector<int>& indices, const vector<unsigned long int>& llaves,
+                            const vector<size_t>& desde, const vector<size_t>& hasta,
+                            vector<int>::iterator salida) {
+    struct Cabeza {
+        unsigned long int llave; // llave del elemento en 'pos'
+        size_t pos, fin;
+        int bloque;
+    };
+    vector<Cabeza> cabezas;
+    for (size_t j = 0; j < desde.size(); j++) {
+        if (desde[j] < hasta[j]) cabezas.push_back({llaves[indices[desde[j]]], desde[j], hasta[j], (int)j});
+    }
+    // Montículo de mínimos: la cabeza de arriba es la que sale; al avanzarla solo se
+    // hunde una vez en lugar de sacarla y volver a meterla
+    auto antes = [](const Cabeza& a, const Cabeza& b) {
+        return a.llave < b.llave || (a.llave == b.llave && a.bloque < b.bloque);
+    };
+    auto hundir = [&cabezas, &antes](size_t i) {
+        Cabeza actual = cabezas[i];
+        while (true) {
+            size_t hijo = 2 * i + 1;
+            if (hijo >= cabezas.size()) break;
+            if (hijo + 1 < cabezas.size() && antes(cabezas[hijo + 1], cabezas[hijo])) hijo++;
+            if (!antes(cabezas[hijo], actual)) break;
+            cabezas[i] = cabezas[hijo];
+            i = hijo;
+        }
+        cabezas[i] = actual;
+    };
+    for (size_t i = cabezas.size() / 2; i-- > 0;) hundir(i);
+    while (cabezas.size() > 1) {
+        Cabeza& c = cabezas[0];
+        *salida++ = indices[c.pos++];
+        if (c.pos < c.fin) {
+            c.llave = llaves[indices[c.pos]];
+        } else {
+            c = cabezas.back();
+            cabezas.pop_back();
+        }
+        hundir(0);
+    }
+    if (!cabezas.empty()) copy(indices.begin() + cabezas[0].pos, indices.begin() + cabezas[0].fin, salida);
+}
+
+// Ordena 'indices' por llaves[indice] de forma estable usando hasta 'hilos' hilos
+inline void ordenarIndicesParalelo(vector<int>& indices, const vector<unsigned long int>& llaves, int hilos) {
+    auto menor = [&llaves](int a, int b) { return llaves[a] < llaves[b]; };
+
+    size_t n = indices.size();
+    hilos = resolverHilos(hilos);
+    if (hilos > (int)(n / MIN_POR_HILO)) hilos = n / MIN_POR_HILO;
+    if (hilos <= 1) {
+        stable_sort(indices.begin(), indices.end(), menor);
+        return;
+    }
+
+    // Límites de cada bloque: [cortes[i], cortes[i+1])
+    vector<size_t> cortes(hilos + 1);
+    for (int i = 0; i <= hilos; i++) cortes[i] = n * i / hilos;
+
+    // 1. Cada hilo ordena su bloque
+    vector<thread> trabajadores;
+    for (int i = 0; i < hilos; i++) {
+        trabajadores.emplace_back([&indices, &cortes, &menor, i]() {
+            stable_sort(indices.begin() + cortes[i], indices.begin() + cortes[i + 1], menor);
+        });
+    }
+    for (size_t i = 0; i < trabajadores.size(); i++) trabajadores[i].join();
+
+    // 2. Cortes de la salida y, para cada uno, dónde queda en cada bloque
+    vector<vector<size_t>> divisiones(hilos + 1);
+    for (int t = 0; t <= hilos; t++) coRango(indices, llaves, cortes, n * t / hilos, divisiones[t]);
+
+    // 3. Cada hilo mezcla su rebanada de los k bloques
+    vector<int> auxiliar(n);
+    trabajadores.clear();
+    for (int t = 0; t < hilos; t++) {
+        trabajadores.emplace_back([&indices, &llaves, &auxiliar, &divisiones, t, n, hilos]() {
+            mezclarRebanada(indices, llaves, divisiones[t], divisiones[t + 1], auxiliar.begin() + n * t / hilos);
+        });
+    }
+    for (size_t i = 0; i < trabajadores.size(); i++) trabajadores[i].join();
+    indices.swap(auxiliar);
+}
+
+#endif
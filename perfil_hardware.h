@@ -0,0 +1,159 @@
+/*
+PERFIL CON CONTADORES DE HARDWARE
+El tiempo de reloj no dice si una fase está limitada por fallos de caché o por saltos mal
+predichos. Con --perfil cada fase caliente (ingesta, ordenamiento, agregarArista, índices,
+matriz de adyacencia) se envuelve con contadores de Linux (perf_event_open):
+  ciclos, instrucciones, fallos de L1 de datos, fallos del último nivel de caché y saltos mal predichos
+y se reporta por fase el IPC y los fallos por registro procesado.
+- Los contadores se abren en el hilo que mide y heredan a los hilos que éste cree
+  (el ordenamiento paralelo y los fragmentos quedan incluidos)
+- Las fases pueden medirse desde varios hilos a la vez (el menú mientras la carga sigue
+  en segundo plano); la lista de mediciones está protegida con un mutex
+- Si el sistema no permite contadores (perf_event_paranoid, contenedores, otro SO) o falta
+  alguno, se reporta como n/d y se sigue midiendo el tiempo de reloj
+
+Autores: Equipo SProblema 5
+ - Franco Varela Villegas - A01199186
+ - Nerik Nieto Gutiérrez - A01739652
+ - Eduardo Mora Howard - A00829920
+*/
+
+#ifndef PERFIL_HARDWARE_H
+#define PERFIL_HARDWARE_H
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <cerrno>
+#include <mutex>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+using namespace std;
+
+#define NUM_CONTADORES 5
+#define CONTADOR_CICLOS 0
+#define CONTADOR_INSTRUCCIONES 1
+#define CONTADOR_FALLOS_L1 2
+#define CONTADOR_FALLOS_LLC 3
+#define CONTADOR_FALLOS_SALTO 4
+
+struct MedicionFase {
+    string nombre;
+    size_t registros = 0;
+    double segundos = 0;
+    uint64_t valores[NUM_CONTADORES] = {0};
+    bool disponible[NUM_CONTADORES] = {false};
+};
+
+struct Perfilador {
+    vector<MedicionFase> fases;
+    string motivo; // por qué faltan contadores (vacío si todos abrieron)
+    mutable mutex candado; // protege 'fases' y 'motivo'
+
+#ifdef __linux__
+    static int abrirContador(uint32_t tipo, uint64_t configuracion) {
+        struct perf_event_attr atributos;
+        memset(&atributos, 0, sizeof(atributos));
+        atributos.size = sizeof(atributos);
+        atributos.type = tipo;
+        atributos.config = configuracion;
+        atributos.disabled = 1;
+        atributos.inherit = 1;          // también los hilos creados durante la fase
+        atributos.exclude_kernel = 1;
+        atributos.exclude_hv = 1;
+        atributos.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return syscall(__NR_perf_event_open, &atributos, 0, -1, -1, 0);
+    }
+
+    // Abre los cinco contadores en el hilo actual; los que fallen quedan en -1
+    void abrir(int descriptores[NUM_CONTADORES]) {
+        const uint64_t fallosL1 = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                                | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        descriptores[CONTADOR_CICLOS] = abrirContador(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        descriptores[CONTADOR_INSTRUCCIONES] = abrirContador(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        descriptores[CONTADOR_FALLOS_L1] = abrirContador(PERF_TYPE_HW_CACHE, fallosL1);
+        descriptores[CONTADOR_FALLOS_LLC] = abrirContador(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        descriptores[CONTADOR_FALLOS_SALTO] = abrirContador(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        for (int c = 0; c < NUM_CONTADORES; c++) {
+            if (descriptores[c] < 0) {
+                string error = strerror(errno);
+                lock_guard<mutex> guardia(candado);
+                if (motivo.empty()) motivo = error;
+            }
+        }
+    }
+#endif
+
+    // Corre 'trabajo' con los contadores encendidos y guarda la medición. 'registros' se
+    // evalúa al terminar la fase (la ingesta cuenta sus líneas mientras avanza)
+    template <typename Trabajo, typename Registros>
+    void medir(const char* nombre, Trabajo trabajo, Registros registros) {
+        MedicionFase fase;
+        fase.nombre = nombre;
+#ifdef __linux__
+        int descriptores[NUM_CONTADORES];
+        abrir(descriptores);
+        for (int c = 0; c < NUM_CONTADORES; c++) {
+            if (descriptores[c] >= 0) {
+                ioctl(descriptores[c], PERF_EVENT_IOC_RESET, 0);
+                ioctl(descriptores[c], PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+        auto inicio = chrono::steady_clock::now();
+        trabajo();
+        fase.segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+        fase.registros = registros();
+#ifdef __linux__
+        for (int c = 0; c < NUM_CONTADORES; c++) {
+            if (descriptores[c] < 0) continue;
+            ioctl(descriptores[c], PERF_EVENT_IOC_DISABLE, 0);
+            uint64_t lectura[3]; // valor, tiempo habilitado, tiempo contando
+            if (read(descriptores[c], lectura, sizeof(lectura)) == (ssize_t)sizeof(lectura) && lectura[2] > 0) {
+                // Si el kernel multiplexó los contadores, se escala al tiempo completo
+                fase.valores[c] = lectura[2] < lectura[1] ? (uint64_t)((double)lectura[0] * lectura[1] / lectura[2]) : lectura[0];
+                fase.disponible[c] = true;
+            }
+            close(descriptores[c]);
+        }
+#endif
+        lock_guard<mutex> guardia(candado);
+#ifndef __linux__
+        motivo = "perf_event_open solo existe en Linux";
+#endif
+        fases.push_back(fase);
+    }
+
+    // Tabla con IPC y fallos por registro de cada fase
+    void reportar() const {
+        lock_guard<mutex> guardia(candado);
+        printf("\n=== PERFIL DE HARDWARE ===\n");
+        if (!motivo.empty()) printf("(Contadores no disponibles: %s; se muestra n/d)\n", motivo.c_str());
+        printf("%-16s %10s %9s %6s %10s %10s %12s\n", "fase", "registros", "ms", "IPC", "L1d/reg", "LLC/reg", "saltos/reg");
+        for (size_t i = 0; i < fases.size(); i++) {
+            const MedicionFase& f = fases[i];
+            char ipc[16] = "n/d", l1[16] = "n/d", llc[16] = "n/d", saltos[16] = "n/d";
+            if (f.disponible[CONTADOR_CICLOS] && f.disponible[CONTADOR_INSTRUCCIONES] && f.valores[CONTADOR_CICLOS] > 0) {
+                snprintf(ipc, sizeof(ipc), "%.2f", (double)f.valores[CONTADOR_INSTRUCCIONES] / f.valores[CONTADOR_CICLOS]);
+            }
+            if (f.registros > 0) {
+                if (f.disponible[CONTADOR_FALLOS_L1]) snprintf(l1, sizeof(l1), "%.3f", (double)f.valores[CONTADOR_FALLOS_L1] / f.registros);
+                if (f.disponible[CONTADOR_FALLOS_LLC]) snprintf(llc, sizeof(llc), "%.3f", (double)f.valores[CONTADOR_FALLOS_LLC] / f.registros);
+                if (f.disponible[CONTADOR_FALLOS_SALTO]) snprintf(saltos, sizeof(saltos), "%.3f", (double)f.valores[CONTADOR_FALLOS_SALTO] / f.registros);
+            }
+            printf("%-16s %10zu %9.1f %6s %10s %10s %12s\n", f.nombre.c_str(), f.registros, f.segundos * 1000, ipc, l1, llc, saltos);
+        }
+        fflush(stdout);
+    }
+};
+
+#endif
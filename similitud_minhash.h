@@ -0,0 +1,175 @@
+/*
+RESTAURANTES CON MENÚ PARECIDO (MINHASH + LSH)
+La similitud entre dos restaurantes es la de Jaccard entre sus conjuntos de platillos
+(las aristas Platillo -> Restaurante del grafo). Comparar todos contra todos no escala, así que:
+- Cada restaurante se resume en una firma de PERMUTACIONES_MINHASH valores: para cada función
+  hash, el platillo con el hash mínimo. Dos firmas coinciden en una posición con probabilidad
+  igual a la similitud de Jaccard
+- En modo ponderado el hash de cada platillo se divide entre el peso de la arista (número de
+  pedidos): -ln(U)/peso. Así la probabilidad de coincidir es la Jaccard probabilística, que
+  toma en cuenta cuánto se pide cada platillo
+- LSH por bandas: la firma se parte en BANDAS_LSH bandas de FILAS_POR_BANDA valores; los
+  restaurantes que coinciden en una banda completa caen en la misma cubeta. Una consulta solo
+  compara contra los candidatos de sus cubetas, y a esos sí les calcula la similitud exacta
+La similitud exacta se conserva para medir el recall de la aproximación.
+
+Autores: Equipo SProblema 5
+ - Franco Varela Villegas - A01199186
+ - Nerik Nieto Gutiérrez - A01739652
+ - Eduardo Mora Howard - A00829920
+*/
+
+#ifndef SIMILITUD_MINHASH_H
+#define SIMILITUD_MINHASH_H
+
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+
+#include "bocetos.h"
+
+using namespace std;
+
+#define PERMUTACIONES_MINHASH 128
+// Menos filas por banda = más candidatos y más recall. Con menús de similitud ~0.2-0.3,
+// 3 filas deja cerca de un tercio de los restaurantes como candidatos
+#define FILAS_POR_BANDA 3
+#define BANDAS_LSH (PERMUTACIONES_MINHASH / FILAS_POR_BANDA)
+#define FIRMA_VACIA 0xFFFFFFFFu // restaurante sin platillos
+
+struct RestauranteSimilar {
+    int idRestaurante;
+    double similitud;
+};
+
+inline bool masSimilar(const RestauranteSimilar& a, const RestauranteSimilar& b) {
+    if (a.similitud != b.similitud) return a.similitud > b.similitud;
+    return a.idRestaurante < b.idRestaurante;
+}
+
+struct IndiceSimilitud {
+    bool ponderado = false;
+    vector<vector<pair<int, int>>> menus;   // por restaurante: (platillo, peso) ordenados por platillo
+    vector<vector<uint32_t>> firmas;        // por restaurante: PERMUTACIONES_MINHASH platillos
+    vector<unordered_map<uint64_t, vector<int>>> cubetas; // por banda: llave de la banda -> restaurantes
+
+    int tamano() const { return menus.size(); }
+
+    // Valor de un platillo bajo la permutación i: -ln(U)/peso con U uniforme en (0, 1]
+    static double llaveMinHash(int permutacion, int platillo, int peso) {
+        uint64_t hash = mezclarHash((uint64_t)permutacion << 32 | (uint32_t)platillo);
+        double u = ((hash >> 11) + 1) * (1.0 / 9007199254740992.0); // 2^-53
+        return -log(u) / peso;
+    }
+
+    static uint64_t llaveBanda(const vector<uint32_t>& firma, int banda) {
+        uint64_t llave = banda;
+        for (int f = 0; f < FILAS_POR_BANDA; f++) llave = mezclarHash(llave ^ firma[banda * FILAS_POR_BANDA + f]);
+        return llave;
+    }
+
+    void construir(const vector<vector<pair<int, int>>>& menusRestaurante, bool conPesos) {
+        ponderado = conPesos;
+        menus = menusRestaurante;
+        firmas.assign(menus.size(), vector<uint32_t>(PERMUTACIONES_MINHASH, FIRMA_VACIA));
+        cubetas.assign(BANDAS_LSH, unordered_map<uint64_t, vector<int>>());
+
+        for (size_t r = 0; r < menus.size(); r++) {
+            sort(menus[r].begin(), menus[r].end());
+            if (menus[r].empty()) continue;
+            for (int i = 0; i < PERMUTACIONES_MINHASH; i++) {
+                double minimo = HUGE_VAL;
+                for (size_t j = 0; j < menus[r].size(); j++) {
+                    double llave = llaveMinHash(i, menus[r][j].first, ponderado ? menus[r][j].second : 1);
+                    if (llave < minimo) {
+                        minimo = llave;
+                        firmas[r][i] = menus[r][j].first;
+                    }
+                }
+            }
+            for (int b = 0; b < BANDAS_LSH; b++) cubetas[b][llaveBanda(firmas[r], b)].push_back(r);
+        }
+    }
+
+    // Fracción de posiciones iguales en las firmas
+    double estimar(int a, int b) const {
+        if (menus[a].empty() || menus[b].empty()) return 0;
+        int iguales = 0;
+        for (int i = 0; i < PERMUTACIONES_MINHASH; i++) iguales += firmas[a][i] == firmas[b][i];
+        return (double)iguales / PERMUTACIONES_MINHASH;
+    }
+
+    // Jaccard exacta; en modo ponderado, la Jaccard probabilística:
+    // suma sobre platillos comunes i de 1 / sum_j max(x_j/x_i, y_j/y_i)
+    double exacta(int a, int b) const {
+        const vector<pair<int, int>>& x = menus[a];
+        const vector<pair<int, int>>& y = menus[b];
+        if (x.empty() || y.empty()) return 0;
+
+        // Unión de los dos menús con el peso en cada lado (0 si no lo sirve)
+        vector<pair<double, double>> pesos;
+        size_t i = 0, j = 0;
+        while (i < x.size() || j < y.size()) {
+            if (j == y.size() || (i < x.size() && x[i].first < y[j].first)) pesos.push_back(make_pair(x[i++].second, 0.0));
+            else if (i == x.size() || y[j].first < x[i].first) pesos.push_back(make_pair(0.0, y[j++].second));
+            else pesos.push_back(make_pair(x[i++].second, y[j++].second));
+        }
+
+        if (!ponderado) {
+            int comunes = 0;
+            for (size_t k = 0; k < pesos.size(); k++) comunes += pesos[k].first > 0 && pesos[k].second > 0;
+            return (double)comunes / pesos.size();
+        }
+        double total = 0;
+        for (size_t k = 0; k < pesos.size(); k++) {
+            if (pesos[k].first == 0 || pesos[k].second == 0) continue;
+            double denominador = 0;
+            for (size_t l = 0; l < pesos.size(); l++) {
+                denominador += max(pesos[l].first / pesos[k].first, pesos[l].second / pesos[k].second);
+            }
+            total += 1 / denominador;
+        }
+        return total;
+    }
+
+    // Top K por LSH: solo se comparan (con la similitud exacta) los restaurantes que comparten alguna cubeta
+    vector<RestauranteSimilar> similares(int id, int k, size_t* candidatos = nullptr) const {
+        vector<RestauranteSimilar> resultado;
+        if (candidatos) *candidatos = 0;
+        if (menus[id].empty()) return resultado;
+        vector<char> visto(menus.size(), 0);
+        visto[id] = 1;
+        for (int b = 0; b < BANDAS_LSH; b++) {
+            auto cubeta = cubetas[b].find(llaveBanda(firmas[id], b));
+            if (cubeta == cubetas[b].end()) continue;
+            for (size_t c = 0; c < cubeta->second.size(); c++) {
+                int otro = cubeta->second[c];
+                if (visto[otro]) continue;
+                visto[otro] = 1;
+                resultado.push_back({otro, exacta(id, otro)});
+            }
+        }
+        if (candidatos) *candidatos = resultado.size();
+        return mejores(resultado, k);
+    }
+
+    // Top K comparando contra todos con la similitud exacta
+    vector<RestauranteSimilar> similaresExactos(int id, int k) const {
+        vector<RestauranteSimilar> resultado;
+        for (int otro = 0; otro < tamano(); otro++) {
+            if (otro != id) resultado.push_back({otro, exacta(id, otro)});
+        }
+        return mejores(resultado, k);
+    }
+
+    static vector<RestauranteSimilar> mejores(vector<RestauranteSimilar>& todos, int k) {
+        size_t tope = min((size_t)max(k, 0), todos.size());
+        partial_sort(todos.begin(), todos.begin() + tope, todos.end(), masSimilar);
+        todos.resize(tope);
+        return todos;
+    }
+};
+
+#endif
@@ -0,0 +1,165 @@
+/*
+TOKENIZADOR SIMD DE LA BITÁCORA
+En lugar de buscar cada campo con strstr/strrchr línea por línea, se recorre el texto en
+bloques de 64 bytes y con instrucciones vectoriales se marcan de una vez los caracteres
+que dan estructura a la línea:
+  '\n'  fin de línea
+  ':'   separadores de la hora y los marcadores "R:" / "O:"
+  '('   ')'  delimitadores del precio
+Cada bloque produce una máscara de 64 bits por carácter; luego se recorren solo los bits
+encendidos, en orden, con una pequeña máquina de estados por línea.
+Variantes: AVX2 y SSE2 (x86-64) y una escalar para cualquier otra arquitectura. La mejor
+disponible se escoge en tiempo de ejecución.
+
+Autores: Equipo SProblema 5
+ - Franco Varela Villegas - A01199186
+ - Nerik Nieto Gutiérrez - A01739652
+ - Eduardo Mora Howard - A00829920
+*/
+
+#ifndef TOKENIZADOR_SIMD_H
+#define TOKENIZADOR_SIMD_H
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define TOKENIZADOR_X86 1
+#endif
+
+using namespace std;
+
+// Bit i encendido = el byte i del bloque es ese carácter
+struct MascarasBloque {
+    uint64_t saltos;
+    uint64_t dosPuntos;
+    uint64_t abre;
+    uint64_t cierra;
+};
+
+typedef void (*FuncionMascaras)(const char* bloque, MascarasBloque& m);
+
+// --- VARIANTES ---
+
+inline void mascarasEscalar(const char* bloque, MascarasBloque& m) {
+    m.saltos = m.dosPuntos = m.abre = m.cierra = 0;
+    for (int i = 0; i < 64; i++) {
+        uint64_t bit = 1ULL << i;
+        switch (bloque[i]) {
+            case '\n': m.saltos |= bit; break;
+            case ':': m.dosPuntos |= bit; break;
+            case '(': m.abre |= bit; break;
+            case ')': m.cierra |= bit; break;
+        }
+    }
+}
+
+#ifdef TOKENIZADOR_X86
+
+inline void mascarasSSE2(const char* bloque, MascarasBloque& m) {
+    const __m128i salto = _mm_set1_epi8('\n'), dosPuntos = _mm_set1_epi8(':');
+    const __m128i abre = _mm_set1_epi8('('), cierra = _mm_set1_epi8(')');
+    m.saltos = m.dosPuntos = m.abre = m.cierra = 0;
+    for (int i = 0; i < 4; i++) {
+        __m128i datos = _mm_loadu_si128((const __m128i*)(bloque + 16 * i));
+        m.saltos |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(datos, salto)) << (16 * i);
+        m.dosPuntos |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(datos, dosPuntos)) << (16 * i);
+        m.abre |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(datos, abre)) << (16 * i);
+        m.cierra |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(datos, cierra)) << (16 * i);
+    }
+}
+
+__attribute__((target("avx2")))
+inline void mascarasAVX2(const char* bloque, MascarasBloque& m) {
+    const __m256i salto = _mm256_set1_epi8('\n'), dosPuntos = _mm256_set1_epi8(':');
+    const __m256i abre = _mm256_set1_epi8('('), cierra = _mm256_set1_epi8(')');
+    __m256i bajo = _mm256_loadu_si256((const __m256i*)bloque);
+    __m256i alto = _mm256_loadu_si256((const __m256i*)(bloque + 32));
+    m.saltos = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bajo, salto))
+             | (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(alto, salto)) << 32;
+    m.dosPuntos = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bajo, dosPuntos))
+                | (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(alto, dosPuntos)) << 32;
+    m.abre = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bajo, abre))
+           | (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(alto, abre)) << 32;
+    m.cierra = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bajo, cierra))
+             | (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(alto, cierra)) << 32;
+}
+
+#endif
+
+// Escoge la variante: "auto" toma la mejor que soporte el procesador; si la pedida no
+// está disponible baja a la mejor que sí (avx2 -> sse2 -> escalar). Regresa nullptr si
+// 'preferido' no es un nombre conocido
+inline FuncionMascaras elegirTokenizador(const char* preferido, const char*& nombre) {
+    bool auto_ = strcmp(preferido, "auto") == 0;
+    bool avx2 = strcmp(preferido, "avx2") == 0;
+    bool sse2 = strcmp(preferido, "sse2") == 0;
+    if (!auto_ && !avx2 && !sse2 && strcmp(preferido, "escalar") != 0) return nullptr;
+#ifdef TOKENIZADOR_X86
+    if ((auto_ || avx2) && __builtin_cpu_supports("avx2")) {
+        nombre = "avx2";
+        return mascarasAVX2;
+    }
+    if (auto_ || avx2 || sse2) {
+        nombre = "sse2";
+        return mascarasSSE2;
+    }
+#endif
+    nombre = "escalar";
+    return mascarasEscalar;
+}
+
+// --- DÍGITOS SIN atoi ---
+
+// Convierte 'len' dígitos ya delimitados. Regresa -1 si alguno no es dígito
+inline int leerDigitos(const char* p, int len) {
+    if (len <= 0 || len > 9) return -1;
+    int valor = 0;
+    for (int i = 0; i < len; i++) {
+        unsigned int d = (unsigned char)p[i] - '0';
+        if (d > 9) return -1;
+        valor = valor * 10 + d;
+    }
+    return valor;
+}
+
+// --- ESTADO POR LÍNEA ---
+// Posiciones (relativas al texto) de los caracteres estructurales de la línea actual
+struct EstadoLinea {
+    size_t inicio;
+    size_t horaMinuto;   // ':' entre hora y minutos
+    size_t minutoSegundo;// ':' entre minutos y segundos
+    size_t marcaR;       // ':' de "R:"
+    size_t marcaO;       // ':' de " O:"
+    size_t abre;         // último '(' después de "O:"
+    size_t cierra;       // ')' después de ese '('
+
+    void reiniciar(size_t nuevoInicio) {
+        inicio = nuevoInicio;
+        horaMinuto = minutoSegundo = marcaR = marcaO = abre = cierra = 0;
+    }
+
+    // Clasifica un ':' según lo que ya se vio en la línea y el carácter anterior
+    void dosPuntos(const char* texto, size_t i) {
+        if (horaMinuto == 0) horaMinuto = i;
+        else if (minutoSegundo == 0) minutoSegundo = i;
+        else if (marcaR == 0) {
+            if (texto[i - 1] == 'R') marcaR = i;
+        } else if (marcaO == 0) {
+            if (texto[i - 1] == 'O' && texto[i - 2] == ' ') marcaO = i;
+        }
+    }
+
+    void parentesis(size_t i, bool esApertura) {
+        if (marcaO == 0) return;
+        if (esApertura) {
+            abre = i;
+            cierra = 0;
+        } else if (abre != 0 && cierra == 0) {
+            cierra = i;
+        }
+    }
+};
+
+#endif